@@ -119,6 +119,8 @@ endif()
 
 if (TFM_MULTI_CORE_TOPOLOGY)
     install(FILES       ${INTERFACE_SRC_DIR}/multi_core/tfm_ns_mailbox.c
+                        ${INTERFACE_SRC_DIR}/multi_core/tfm_ns_mailbox_arena.c
+                        ${INTERFACE_SRC_DIR}/multi_core/tfm_ns_mailbox_stats.c
                         ${INTERFACE_SRC_DIR}/multi_core/tfm_multi_core_ns_api.c
                         ${INTERFACE_SRC_DIR}/multi_core/tfm_multi_core_psa_ns_api.c
                         ${INTERFACE_SRC_DIR}/multi_core/tfm_ns_mailbox_rtos_api.c
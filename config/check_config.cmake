@@ -1,5 +1,7 @@
 #-------------------------------------------------------------------------------
 # Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+# Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+# or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -29,6 +31,9 @@ tfm_invalid_config(TFM_ISOLATION_LEVEL GREATER 1 AND NOT TFM_PSA_API)
 
 tfm_invalid_config(TFM_MULTI_CORE_TOPOLOGY AND NOT TFM_PSA_API)
 
+tfm_invalid_config(TFM_SPM_MEM_CHECK_CACHE_SIZE GREATER 0 AND NOT TFM_PSA_API)
+tfm_invalid_config(TFM_SPM_MEM_CHECK_CACHE_SIZE GREATER 0 AND TFM_ISOLATION_LEVEL EQUAL 1)
+
 tfm_invalid_config(TEST_S  AND TEST_PSA_API)
 tfm_invalid_config(TEST_NS AND TEST_PSA_API)
 
@@ -45,6 +50,8 @@ tfm_invalid_config(TEST_PSA_API STREQUAL "PROTECTED_STORAGE" AND NOT TFM_PARTITI
 tfm_invalid_config(TEST_PSA_API STREQUAL "STORAGE" AND NOT TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
 tfm_invalid_config(TEST_PSA_API STREQUAL "STORAGE" AND NOT TFM_PARTITION_PROTECTED_STORAGE)
 
+tfm_invalid_config(CRYPTO_AEAD_MULTIPART_ENABLED AND CRYPTO_AEAD_MODULE_DISABLED)
+
 tfm_invalid_config(CRYPTO_HW_ACCELERATOR_OTP_STATE AND NOT CRYPTO_HW_ACCELERATOR)
 tfm_invalid_config(CRYPTO_HW_ACCELERATOR_OTP_STATE AND NOT (CRYPTO_HW_ACCELERATOR_OTP_STATE STREQUAL "ENABLED" OR CRYPTO_HW_ACCELERATOR_OTP_STATE STREQUAL "PROVISIONING"))
 
@@ -64,6 +71,42 @@ tfm_invalid_config(TFM_CODE_SHARING STREQUAL "OFF" AND TFM_CODE_SHARING_PATH)
 
 tfm_invalid_config(TFM_SP_META_PTR_ENABLE AND NOT TFM_PSA_API)
 
+####################### SPM debug statistics ###################################
+
+tfm_invalid_config(TFM_SPM_DEBUG_STATS AND NOT TFM_PSA_API)
+
+####################### SPM trace ##############################################
+
+tfm_invalid_config(TFM_SPM_TRACE AND NOT TFM_PSA_API)
+
+####################### Priority inheritance ###################################
+
+tfm_invalid_config(TFM_SPM_PRIORITY_INHERITANCE AND NOT TFM_PSA_API)
+
+####################### Buffered SPM log #######################################
+
+tfm_invalid_config(TFM_SPM_LOG_BUFFERED AND NOT TFM_MULTI_CORE_TOPOLOGY)
+
+####################### Mailbox statistics #####################################
+
+tfm_invalid_config(TFM_MULTI_CORE_MAILBOX_STATS AND NOT TFM_MULTI_CORE_TOPOLOGY)
+
+####################### Lightweight SFN call ###################################
+
+tfm_invalid_config(TFM_SFN_LIGHTWEIGHT_CALL AND TFM_PSA_API)
+tfm_invalid_config(TFM_SFN_LIGHTWEIGHT_CALL AND NOT TFM_ISOLATION_LEVEL EQUAL 1)
+
+####################### MM-IOVEC ###############################################
+
+tfm_invalid_config(PSA_FRAMEWORK_HAS_MM_IOVEC AND NOT TFM_PSA_API)
+tfm_invalid_config(PSA_FRAMEWORK_HAS_MM_IOVEC AND NOT TFM_ISOLATION_LEVEL EQUAL 1)
+
+####################### PSA Proxy ##############################################
+
+tfm_invalid_config(PSA_PROXY_DIRECT_IOVEC AND NOT TFM_PARTITION_PSA_PROXY)
+tfm_invalid_config(PSA_PROXY_DIRECT_IOVEC AND NOT PSA_FRAMEWORK_HAS_MM_IOVEC)
+tfm_invalid_config(PSA_PROXY_REPLY_DOORBELL AND NOT TFM_PARTITION_PSA_PROXY)
+
 ####################### Firmware Update Parttion ###############################
 
 tfm_invalid_config(TFM_PARTITION_FIRMWARE_UPDATE AND NOT TFM_PARTITION_PLATFORM)
@@ -33,6 +33,8 @@ set(TFM_EXTRA_PARTITION_PATHS           ""          CACHE PATH      "List of ext
 
 set(TFM_SPM_LOG_LEVEL                   TFM_SPM_LOG_LEVEL_INFO          CACHE STRING    "Set default SPM log level as INFO level")
 set(TFM_PARTITION_LOG_LEVEL             TFM_PARTITION_LOG_LEVEL_INFO    CACHE STRING    "Set default Secure Partition log level as INFO level")
+set(TFM_SPM_LOG_BUFFERED                OFF         CACHE BOOL      "Record SPM and partition logs into a buffer which is output when the secure core is idle")
+set(TFM_SPM_LOG_BUFFER_SIZE             1024        CACHE STRING    "Size in bytes of the SPM log buffer, must be a power of two")
 
 set(TFM_CODE_SHARING                    OFF         CACHE PATH      "Enable code sharing between MCUboot and secure firmware")
 set(TFM_CODE_SHARING_PATH               ""          CACHE PATH      "Path to repo which shares code with secure firmware")
@@ -46,10 +48,18 @@ set(TFM_CODE_COVERAGE                   OFF         CACHE BOOL      "Whether to
 
 set(TFM_SP_META_PTR_ENABLE              OFF         CACHE BOOL      "Use Partition Metadata Pointer")
 
+set(PSA_FRAMEWORK_HAS_MM_IOVEC          OFF         CACHE BOOL      "Enable MM-IOVEC, allowing services to access client input and output vectors in place (isolation level 1 only)")
+
 set(TFM_PXN_ENABLE                      OFF         CACHE BOOL      "Use Privileged execute never (PXN)")
 
 set(TFM_EXCEPTION_INFO_DUMP             OFF         CACHE BOOL      "On fatal errors in the secure firmware, capture info about the exception. Print the info if the SPM log level is sufficient.")
 
+set(TFM_SPM_DEBUG_STATS                 OFF         CACHE BOOL      "Allow PSA RoT partitions to read SPM debug statistics, such as connection handle pool usage")
+set(TFM_SPM_MEM_CHECK_CACHE_SIZE        0           CACHE STRING    "Number of memory ranges that passed the SPM memory check to cache, each reused only by the same partition. 0 to disable the cache (isolation level 2 and 3 only)")
+set(TFM_SPM_TRACE                       OFF         CACHE BOOL      "Record SPM IPC events into a trace buffer, decoded by tools/spm_trace_decode.py")
+set(TFM_SPM_PRIORITY_INHERITANCE        OFF         CACHE BOOL      "Run a partition at the highest priority of the clients blocked on it")
+set(TFM_SFN_LIGHTWEIGHT_CALL            OFF         CACHE BOOL      "In library mode, call PSA RoT services from PSA RoT partitions without iovec checks and context save")
+
 set(TFM_CODE_SHARING                    OFF         CACHE PATH      "Enable code sharing between MCUboot and secure firmware")
 set(TFM_CODE_SHARING_PATH               ""          CACHE PATH      "Path to repo which shares code with secure firmware")
 
@@ -86,6 +96,7 @@ set(MCUBOOT_NS_IMAGE_MIN_VER            0.0.0+0     CACHE STRING    "Minimum ver
 
 set(TFM_MULTI_CORE_TOPOLOGY             OFF         CACHE BOOL      "Whether to build for a dual-cpu architecture")
 set(NUM_MAILBOX_QUEUE_SLOT              1           CACHE BOOL      "Number of mailbox queue slots")
+set(TFM_MULTI_CORE_MAILBOX_STATS        OFF         CACHE BOOL      "Collect mailbox statistics in the NSPE mailbox queue, readable from both cores. The NS image must be built with the generated mailbox configuration")
 
 set(DEBUG_AUTHENTICATION                CHIP_DEFAULT CACHE STRING   "Debug authentication setting. [CHIP_DEFAULT, NONE, NS_ONLY, FULL")
 set(SECURE_UART1                        OFF         CACHE BOOL      "Enable secure UART1")
@@ -132,8 +143,12 @@ set(CRYPTO_CIPHER_MODULE_DISABLED       FALSE       CACHE BOOL      "Disable PSA
 set(CRYPTO_GENERATOR_MODULE_DISABLED    FALSE       CACHE BOOL      "Disable PSA Crypto Key Derivation module")
 set(CRYPTO_ASYMMETRIC_MODULE_DISABLED   FALSE       CACHE BOOL      "Disable PSA Crypto Asymmetric key module")
 set(CRYPTO_KEY_DERIVATION_MODULE_DISABLED FALSE     CACHE BOOL      "Disable PSA Crypto key derivation module")
+set(CRYPTO_AEAD_MULTIPART_ENABLED       FALSE       CACHE BOOL      "Enable PSA Crypto multi-part AEAD operations. Requires a Mbed Crypto version implementing the multi-part AEAD API")
 set(CRYPTO_IOVEC_BUFFER_SIZE            5120        CACHE STRING    "Default size of the internal scratch buffer used for PSA FF IOVec allocations")
 
+set(PSA_PROXY_DIRECT_IOVEC                OFF         CACHE BOOL      "Pass large client vectors to the Secure Enclave in place instead of copying them into the PSA Proxy shared memory. The Secure Enclave must be able to access the memory of the Host's secure clients")
+set(PSA_PROXY_REPLY_DOORBELL              OFF         CACHE BOOL      "PSA Proxy blocks until its doorbell is rung instead of polling the mailbox while calls are in flight. The platform's mailbox reply IRQ handler must call tfm_spm_notify_doorbell_isr(TFM_SP_PSA_PROXY)")
+
 set(TFM_PARTITION_INITIAL_ATTESTATION   ON          CACHE BOOL      "Enable Initial Attestation partition")
 set(SYMMETRIC_INITIAL_ATTESTATION       OFF         CACHE BOOL      "Use symmetric crypto for inital attestation")
 set(ATTEST_INCLUDE_OPTIONAL_CLAIMS      ON          CACHE BOOL      "Include optional claims in initial attestation token")
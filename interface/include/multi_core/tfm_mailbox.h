@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,6 +21,7 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "cmsis_compiler.h"
 #include "psa/client.h"
 #include "tfm_mailbox_config.h"
 
@@ -44,6 +47,22 @@ extern "C" {
 #define MAILBOX_INIT_ERROR                  (INT32_MIN + 7)
 #define MAILBOX_GENERIC_ERROR               (INT32_MIN + 8)
 
+/*
+ * The ring indices shared by NSPE and SPE are placed in separate cache lines,
+ * so that the producer and the consumer of a ring never write the same line.
+ */
+#ifndef MAILBOX_CACHE_LINE_SIZE
+#define MAILBOX_CACHE_LINE_SIZE             (32)
+#endif
+
+/*
+ * Orders the accesses to a mailbox slot against the update of the ring index
+ * which passes the slot to the peer core.
+ */
+#ifndef MAILBOX_MEM_BARRIER
+#define MAILBOX_MEM_BARRIER()               __DMB()
+#endif
+
 /*
  * This structure holds the parameters used in a PSA client call.
  */
@@ -117,21 +136,135 @@ struct ns_mailbox_slot_t {
     struct mailbox_reply_t reply;
 };
 
-typedef uint32_t   mailbox_queue_status_t;
+/*
+ * The consumer of a ring is draining or polling it. The producer can skip the
+ * notification to the consumer.
+ */
+#define MAILBOX_RING_F_NO_NOTIFY            (1UL << 0)
+
+/*
+ * A ring index with its flags, alone in a cache line. Both are only written by
+ * the owner of the index.
+ */
+struct mailbox_ring_idx_t {
+    volatile uint32_t        idx;
+    volatile uint32_t        flags;
+    uint8_t                  reserved[MAILBOX_CACHE_LINE_SIZE -
+                                      2 * sizeof(uint32_t)];
+};
+
+/* Size of the entries of a ring, rounded up to whole cache lines */
+#define MAILBOX_RING_ENTRIES_SIZE                                        \
+    (((NUM_MAILBOX_QUEUE_SLOT + MAILBOX_CACHE_LINE_SIZE - 1) /           \
+      MAILBOX_CACHE_LINE_SIZE) * MAILBOX_CACHE_LINE_SIZE)
+
+/*
+ * A single-producer single-consumer ring of mailbox queue slot indices.
+ * 'head' is only written by the producer and 'tail' only by the consumer.
+ * Both run from 0 to (2 * NUM_MAILBOX_QUEUE_SLOT - 1), so that a full ring can
+ * be told from an empty one.
+ */
+struct mailbox_ring_t {
+    struct mailbox_ring_idx_t head;             /* Next entry to produce */
+    struct mailbox_ring_idx_t tail;             /* Next entry to consume */
+    volatile uint8_t          entries[MAILBOX_RING_ENTRIES_SIZE];
+};
+
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+/* Number of PSA client call types. Call type N is counted at index N - 1. */
+#define MAILBOX_STATS_CALL_TYPE_NUM         MAILBOX_PSA_CLOSE
+
+/*
+ * Number of latency histogram buckets. Bucket N counts the values in
+ * [2^(N-1), 2^N), bucket 0 the value 0 and the last one all the larger values.
+ */
+#define MAILBOX_STATS_HIST_NUM              24
+
+/*
+ * Mailbox statistics written by NSPE. Latencies are measured in
+ * tfm_ns_mailbox_hal_get_timestamp() ticks.
+ */
+struct mailbox_ns_stats_t {
+    uint32_t nr_calls[MAILBOX_STATS_CALL_TYPE_NUM]; /* Calls submitted */
+    uint32_t nr_queue_full;             /* Times a call waited for or failed
+                                         * to get a free slot
+                                         */
+    uint32_t nr_doorbell_tx;            /* Notifications sent to SPE */
+    uint32_t nr_doorbell_rx;            /* Notifications received from SPE */
+    uint32_t max_used_slots;            /* Maximum number of slots in use */
+    uint32_t rtt_hist[MAILBOX_STATS_HIST_NUM];
+                                        /* Latency from submitting a call to
+                                         * fetching its reply
+                                         */
+};
+
+/*
+ * Mailbox statistics written by SPE. Latencies are measured in
+ * tfm_hal_get_timestamp() ticks.
+ */
+struct mailbox_spe_stats_t {
+    uint32_t nr_msgs[MAILBOX_STATS_CALL_TYPE_NUM]; /* Messages fetched */
+    uint32_t nr_doorbell_rx;            /* Notifications received from NSPE */
+    uint32_t nr_doorbell_tx;            /* Notifications sent to NSPE */
+    uint32_t proc_hist[MAILBOX_STATS_HIST_NUM];
+                                        /* Latency from fetching a message to
+                                         * replying to it
+                                         */
+};
+
+/*
+ * Mailbox statistics in the NSPE mailbox queue, readable from both cores. Each
+ * part is only written by one core and starts a new cache line. A reader can
+ * see the counters updated while it copies them.
+ */
+struct mailbox_stats_t {
+    struct mailbox_ns_stats_t  ns __ALIGNED(MAILBOX_CACHE_LINE_SIZE);
+    struct mailbox_spe_stats_t spe __ALIGNED(MAILBOX_CACHE_LINE_SIZE);
+};
+
+/* Add a latency value into a histogram */
+static inline void mailbox_stats_hist_add(uint32_t *hist, uint32_t val)
+{
+    uint32_t bucket = 0;
 
-/* NSPE mailbox queue */
+    while (val && (bucket < MAILBOX_STATS_HIST_NUM - 1)) {
+        val >>= 1;
+        bucket++;
+    }
+
+    hist[bucket]++;
+}
+#endif /* TFM_MULTI_CORE_MAILBOX_STATS */
+
+/*
+ * NSPE mailbox queue. It should be placed at a MAILBOX_CACHE_LINE_SIZE
+ * aligned address to keep the ring indices in separate cache lines.
+ */
 struct ns_mailbox_queue_t {
-    mailbox_queue_status_t   empty_slots;       /* Bitmask of empty slots */
-    mailbox_queue_status_t   pend_slots;        /* Bitmask of slots pending
-                                                 * for SPE handling
+    struct mailbox_ring_t    req_ring;          /* Slots pending for SPE
+                                                 * handling. Produced by NSPE,
+                                                 * consumed by SPE.
                                                  */
-    mailbox_queue_status_t   replied_slots;     /* Bitmask of active slots
-                                                 * containing PSA client call
-                                                 * return result
+    struct mailbox_ring_t    cpl_ring;          /* Slots containing PSA client
+                                                 * call return result.
+                                                 * Produced by SPE, consumed by
+                                                 * NSPE.
                                                  */
 
     struct ns_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
 
+    uintptr_t                arena_base;        /* Base address of the NSPE
+                                                 * shared buffer arena.
+                                                 */
+    size_t                   arena_size;        /* Size of the NSPE shared
+                                                 * buffer arena. 0 if there is
+                                                 * no arena.
+                                                 */
+
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+    struct mailbox_stats_t   stats;             /* Mailbox statistics */
+#endif
+
 #ifdef TFM_MULTI_CORE_TEST
     uint32_t                 nr_tx;             /* The total number of
                                                  * submission of NS PSA Client
@@ -143,11 +276,148 @@ struct ns_mailbox_queue_t {
                                                  * NS thread requests a mailbox
                                                  * queue slot.
                                                  */
-
-    bool                     is_full;           /* Queue if full */
+    uint32_t                 nr_notify_tx;      /* The total number of
+                                                 * notifications sent to SPE.
+                                                 */
+    uint32_t                 nr_notify_rx;      /* The total number of
+                                                 * notifications received from
+                                                 * SPE.
+                                                 */
 #endif
 };
 
+static inline uint32_t mailbox_ring_next(uint32_t idx)
+{
+    return (idx + 1 < 2 * NUM_MAILBOX_QUEUE_SLOT) ? (idx + 1) : 0;
+}
+
+static inline bool mailbox_ring_is_empty(const struct mailbox_ring_t *ring)
+{
+    return ring->head.idx == ring->tail.idx;
+}
+
+/* Ring indices run over [0, 2 * NUM_MAILBOX_QUEUE_SLOT) */
+static inline bool mailbox_ring_idx_is_valid(uint32_t idx)
+{
+    return idx < 2 * NUM_MAILBOX_QUEUE_SLOT;
+}
+
+/*
+ * The number of entries between two valid ring indices. A result greater than
+ * NUM_MAILBOX_QUEUE_SLOT means that the indices are corrupted.
+ */
+static inline uint32_t mailbox_ring_count(uint32_t head, uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) :
+                            (head + 2 * NUM_MAILBOX_QUEUE_SLOT - tail);
+}
+
+/**
+ * \brief Pass a mailbox queue slot to the consumer of a ring. Only called by
+ *        the producer of the ring.
+ *
+ * \param[in] ring              The ring
+ * \param[in] slot_idx          Index of the mailbox queue slot
+ *
+ * \retval MAILBOX_SUCCESS      The slot is passed to the consumer.
+ * \retval MAILBOX_QUEUE_FULL   The ring is full.
+ */
+static inline int32_t mailbox_ring_push(struct mailbox_ring_t *ring,
+                                        uint8_t slot_idx)
+{
+    uint32_t head = ring->head.idx;
+    uint32_t tail = ring->tail.idx;
+
+    if ((head != tail) &&
+        ((head % NUM_MAILBOX_QUEUE_SLOT) == (tail % NUM_MAILBOX_QUEUE_SLOT))) {
+        return MAILBOX_QUEUE_FULL;
+    }
+
+    ring->entries[head % NUM_MAILBOX_QUEUE_SLOT] = slot_idx;
+
+    /* The slot and the entry must be visible before the new head */
+    MAILBOX_MEM_BARRIER();
+    ring->head.idx = mailbox_ring_next(head);
+
+    return MAILBOX_SUCCESS;
+}
+
+/**
+ * \brief Take the next mailbox queue slot from a ring. Only called by the
+ *        consumer of the ring.
+ *
+ * \param[in]  ring             The ring
+ * \param[out] slot_idx         Index of the mailbox queue slot
+ *
+ * \retval MAILBOX_SUCCESS       A slot is taken.
+ * \retval MAILBOX_NO_PEND_EVENT The ring is empty.
+ */
+static inline int32_t mailbox_ring_pop(struct mailbox_ring_t *ring,
+                                       uint8_t *slot_idx)
+{
+    uint32_t tail = ring->tail.idx;
+
+    if (ring->head.idx == tail) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    /* Read the entry and the slot only after the head */
+    MAILBOX_MEM_BARRIER();
+    *slot_idx = ring->entries[tail % NUM_MAILBOX_QUEUE_SLOT];
+
+    ring->tail.idx = mailbox_ring_next(tail);
+
+    return MAILBOX_SUCCESS;
+}
+
+/**
+ * \brief Check whether the consumer of a ring should be notified, after a slot
+ *        is pushed into it. Only called by the producer of the ring.
+ *
+ * \param[in] ring              The ring
+ *
+ * \return true if the consumer should be notified, otherwise false.
+ */
+static inline bool mailbox_ring_need_notify(const struct mailbox_ring_t *ring)
+{
+    /* Read the consumer flags only after the new head is visible */
+    MAILBOX_MEM_BARRIER();
+
+    return !(ring->tail.flags & MAILBOX_RING_F_NO_NOTIFY);
+}
+
+/**
+ * \brief Ask the producer of a ring to skip notifications, while the consumer
+ *        drains or polls the ring. Only called by the consumer of the ring.
+ *
+ * \param[in] ring              The ring
+ */
+static inline void mailbox_ring_disable_notify(struct mailbox_ring_t *ring)
+{
+    ring->tail.flags |= MAILBOX_RING_F_NO_NOTIFY;
+}
+
+/**
+ * \brief Ask the producer of a ring to notify the consumer again. Only called
+ *        by the consumer of the ring.
+ *
+ * \note A slot may be pushed just before the producer sees the change. The
+ *       consumer must drain the ring again if this function returns false.
+ *
+ * \param[in] ring              The ring
+ *
+ * \return true if the ring is empty, otherwise false.
+ */
+static inline bool mailbox_ring_enable_notify(struct mailbox_ring_t *ring)
+{
+    ring->tail.flags &= ~MAILBOX_RING_F_NO_NOTIFY;
+
+    /* Check the head only after the producer can see the cleared flag */
+    MAILBOX_MEM_BARRIER();
+
+    return mailbox_ring_is_empty(ring);
+}
+
 #ifdef __cplusplus
 }
 #endif
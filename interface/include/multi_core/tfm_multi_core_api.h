@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,8 +14,11 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "psa/client.h"
+
 /**
  * \brief Called on the non-secure CPU.
  *        Flags that the non-secure side has completed its initialization.
@@ -36,6 +41,74 @@ int32_t tfm_ns_wait_for_s_cpu_ready(void);
  */
 int32_t tfm_platform_ns_wait_for_s_cpu_ready(void);
 
+#ifndef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/**
+ * \brief The callback to deliver the result of \ref tfm_psa_call_async().
+ *        It is called in the mailbox IRQ handler, or with IRQ disabled by the
+ *        task polling the mailbox. It must not issue PSA client calls.
+ *
+ * \param[in] arg               The argument passed to
+ *                              \ref tfm_psa_call_async().
+ * \param[in] status            The result of the PSA client call.
+ */
+typedef void (*tfm_psa_call_cb_t)(void *arg, psa_status_t status);
+
+/**
+ * \brief Submit a psa_call() to the secure CPU without waiting for the result.
+ *        A single task can keep several calls in flight.
+ *
+ * \note The input and output vectors and the buffers they refer to must stay
+ *       valid until the call is completed.
+ *
+ * \param[in] handle            A handle to an established connection.
+ * \param[in] type              The request type.
+ * \param[in] in_vec            Array of input \ref psa_invec structures.
+ * \param[in] in_len            Number of input \ref psa_invec structures.
+ * \param[in,out] out_vec       Array of output \ref psa_outvec structures.
+ * \param[in] out_len           Number of output \ref psa_outvec structures.
+ * \param[in] cb                The callback to deliver the result. If it is
+ *                              NULL, the result is fetched via \a token.
+ * \param[in] cb_arg            The argument passed to \a cb.
+ * \param[out] token            The token to fetch the result by
+ *                              \ref tfm_psa_call_poll() or
+ *                              \ref tfm_psa_call_wait(). It can be NULL if
+ *                              \a cb is set.
+ *
+ * \retval PSA_SUCCESS                The call is submitted.
+ * \retval PSA_ERROR_CONNECTION_BUSY  Too many calls in flight. Retry later.
+ * \retval PSA_ERROR_INVALID_ARGUMENT Neither \a cb nor \a token is set.
+ * \retval Other return code          Inter-core communication error.
+ */
+psa_status_t tfm_psa_call_async(psa_handle_t handle, int32_t type,
+                                const psa_invec *in_vec, size_t in_len,
+                                psa_outvec *out_vec, size_t out_len,
+                                tfm_psa_call_cb_t cb, void *cb_arg,
+                                uint32_t *token);
+
+/**
+ * \brief Check whether a call submitted by \ref tfm_psa_call_async() is
+ *        completed, without blocking.
+ *
+ * \param[in] token             The token of the call.
+ * \param[out] status           The result of the call, or an inter-core
+ *                              communication error code if the token is
+ *                              invalid. Only written when true is returned.
+ *
+ * \return true if the result is fetched, false if the call is still in flight.
+ */
+bool tfm_psa_call_poll(uint32_t token, psa_status_t *status);
+
+/**
+ * \brief Wait for a call submitted by \ref tfm_psa_call_async() to complete.
+ *        It must be called by the task which submitted the call.
+ *
+ * \param[in] token             The token of the call.
+ *
+ * \return The result of the call, or an inter-core communication error code.
+ */
+psa_status_t tfm_psa_call_wait(uint32_t token);
+#endif /* TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD */
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -20,7 +22,12 @@
 extern "C" {
 #endif
 
-#if !defined(TFM_MULTI_CORE_NS_OS) && (NUM_MAILBOX_QUEUE_SLOT > 1)
+/*
+ * A bare metal client blocks in each synchronous call, so additional slots
+ * only serve asynchronous calls, which the PSA Proxy partition makes.
+ */
+#if !defined(TFM_MULTI_CORE_NS_OS) && !defined(TFM_PARTITION_PSA_PROXY) && \
+    (NUM_MAILBOX_QUEUE_SLOT > 1)
 #error "NUM_MAILBOX_QUEUE_SLOT should be set to 1 for NS bare metal environment"
 #endif
 
@@ -38,6 +45,30 @@ struct ns_mailbox_stats_res_t {
                                          * number of NSPE mailbox slots in use.
                                          */
 };
+
+/**
+ * \brief The structure to hold the average number of notifications per NSPE
+ *        mailbox message
+ */
+struct ns_mailbox_notify_stats_res_t {
+    uint8_t avg_nr_tx;                  /* The value before the decimal point
+                                         * in the average number of
+                                         * notifications sent to SPE.
+                                         */
+    uint8_t avg_nr_tx_tenths;           /* The first digit value after the
+                                         * decimal point in the average
+                                         * number of notifications sent to SPE.
+                                         */
+    uint8_t avg_nr_rx;                  /* The value before the decimal point
+                                         * in the average number of
+                                         * notifications received from SPE.
+                                         */
+    uint8_t avg_nr_rx_tenths;           /* The first digit value after the
+                                         * decimal point in the average
+                                         * number of notifications received
+                                         * from SPE.
+                                         */
+};
 #endif
 
 /**
@@ -70,6 +101,131 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
                                    int32_t client_id,
                                    int32_t *reply);
 
+#ifndef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/**
+ * \brief The callback to deliver the result of an asynchronous PSA client
+ *        call.
+ *
+ * \note It is called in the mailbox IRQ handler, or with IRQ disabled by the
+ *       task polling the mailbox. It must not call NSPE mailbox functions.
+ *
+ * \param[in] arg               The argument passed when the call is submitted.
+ * \param[in] reply             The PSA client call result.
+ */
+typedef void (*tfm_ns_mailbox_cb_t)(void *arg, int32_t reply);
+
+/**
+ * \brief Send PSA client call to SPE via mailbox without waiting for the
+ *        result. A task can keep multiple PSA client calls in flight.
+ *
+ * \note The memory referred by \a params, such as the input and output vectors,
+ *       must stay valid until the call is completed.
+ *
+ * \note An asynchronous call takes the NS OS lock by
+ *       \ref tfm_ns_mailbox_os_lock_try_acquire(), and releases it when its
+ *       result is delivered or fetched. Synchronous calls wait for the lock as
+ *       before.
+ *
+ * \param[in] call_type         PSA client call type
+ * \param[in] params            Parameters used for PSA client call
+ * \param[in] client_id         Optional client ID of non-secure caller.
+ * \param[in] cb                The callback to deliver the result. If it is
+ *                              NULL, the result is fetched via \a token.
+ * \param[in] cb_arg            The argument passed to \a cb.
+ * \param[out] token            The token to fetch the result by
+ *                              \ref tfm_ns_mailbox_client_poll() or
+ *                              \ref tfm_ns_mailbox_client_wait(). It can be
+ *                              NULL if \a cb is set.
+ *
+ * \retval MAILBOX_SUCCESS      The PSA client call is submitted.
+ * \retval MAILBOX_QUEUE_FULL   No free mailbox slot. Retry later.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_client_call_async(uint32_t call_type,
+                                const struct psa_client_params_t *params,
+                                int32_t client_id,
+                                tfm_ns_mailbox_cb_t cb,
+                                void *cb_arg,
+                                uint32_t *token);
+
+/**
+ * \brief Fetch the result of an asynchronous PSA client call without blocking.
+ *        The token is invalid once the result is fetched.
+ *
+ * \param[in] token             The token of the call.
+ * \param[out] reply            The buffer written with PSA client call result.
+ *
+ * \retval MAILBOX_SUCCESS       The call is completed and \a reply is written.
+ * \retval MAILBOX_NO_PEND_EVENT The call is still in flight.
+ * \retval MAILBOX_INVAL_PARAMS  The token is invalid.
+ * \retval Other return code     Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_client_poll(uint32_t token, int32_t *reply);
+
+/**
+ * \brief Wait for and fetch the result of an asynchronous PSA client call.
+ *
+ * \note It must be called by the task which submitted the call, as only that
+ *       task is woken up by the reply.
+ *
+ * \param[in] token             The token of the call.
+ * \param[out] reply            The buffer written with PSA client call result.
+ *
+ * \retval MAILBOX_SUCCESS      The call is completed and \a reply is written.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_client_wait(uint32_t token, int32_t *reply);
+#endif /* TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD */
+
+#ifdef TFM_MULTI_CORE_NS_MAILBOX_ARENA
+/* The maximum number of MAILBOX_CACHE_LINE_SIZE blocks in the arena */
+#ifndef NS_MAILBOX_ARENA_BLOCK_NUM
+#define NS_MAILBOX_ARENA_BLOCK_NUM          128
+#endif
+
+/**
+ * \brief Set up the NSPE shared buffer arena.
+ *        SPE validates the arena once during mailbox initialization. The
+ *        buffers allocated from it are passed in PSA client call parameters
+ *        without per-call memory access checks in SPE.
+ *
+ * \note It must be called before \ref tfm_ns_mailbox_init().
+ *
+ * \param[in] base              The base address of the arena. It must be
+ *                              aligned to MAILBOX_CACHE_LINE_SIZE.
+ * \param[in] size              The size of the arena in bytes.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_arena_init(void *base, size_t size);
+
+/**
+ * \brief Export the NSPE shared buffer arena to SPE via NSPE mailbox queue.
+ *        Invoked by \ref tfm_ns_mailbox_init().
+ *
+ * \param[in] queue             The NSPE mailbox queue.
+ */
+void tfm_ns_mailbox_arena_export(struct ns_mailbox_queue_t *queue);
+
+/**
+ * \brief Allocate a buffer from the NSPE shared buffer arena.
+ *
+ * \param[in] size              The size of the buffer in bytes.
+ *
+ * \return The buffer aligned to MAILBOX_CACHE_LINE_SIZE, or NULL if the arena
+ *         cannot fit it.
+ */
+void *tfm_ns_mailbox_alloc_buf(size_t size);
+
+/**
+ * \brief Release a buffer allocated by \ref tfm_ns_mailbox_alloc_buf().
+ *
+ * \param[in] buf               The buffer to be released.
+ */
+void tfm_ns_mailbox_free_buf(void *buf);
+#endif /* TFM_MULTI_CORE_NS_MAILBOX_ARENA */
+
 #ifdef TFM_MULTI_CORE_NS_OS
 /**
  * \brief Go through mailbox messages already replied by SPE mailbox and
@@ -90,7 +246,57 @@ static inline int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 }
 #endif
 
+#if defined(TFM_MULTI_CORE_NS_OS) && \
+    !defined(TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD)
+/**
+ * \brief Enable or disable the poll mode of NSPE mailbox.
+ *        In poll mode, SPE skips the notification of PSA client call results.
+ *        The tasks waiting for the results poll the mailbox instead of
+ *        sleeping. It saves the inter-core interrupts and the latency to wake
+ *        up tasks during a burst of PSA client calls, at the cost of CPU time.
+ *
+ * \note In poll mode, \ref tfm_ns_mailbox_os_wake_task_isr() is also called by
+ *       a polling task with IRQ disabled.
+ *
+ * \note NS bare metal environment always polls the PSA client call results.
+ *
+ * \param[in] enable            Enable the poll mode if true, otherwise disable
+ *                              it.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_set_poll_mode(bool enable);
+#endif
+
 #ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/*
+ * The number of request lanes in NS mailbox thread. Requests in lane 0 are
+ * submitted first. The lane of a request is selected by
+ * tfm_ns_mailbox_os_mq_get_lane().
+ */
+#ifndef NS_MAILBOX_THREAD_LANE_NUM
+#define NS_MAILBOX_THREAD_LANE_NUM          2
+#endif
+
+/* The maximum number of requests submitted to SPE per notification */
+#ifndef NS_MAILBOX_THREAD_BATCH_MAX
+#define NS_MAILBOX_THREAD_BATCH_MAX         NUM_MAILBOX_QUEUE_SLOT
+#endif
+
+/*
+ * A lane with pending requests is served ahead of the higher priority lanes,
+ * once they have been served this many times in a row while it was waiting.
+ */
+#ifndef NS_MAILBOX_THREAD_LANE_BUDGET
+#define NS_MAILBOX_THREAD_LANE_BUDGET       4
+#endif
+
+#if (NS_MAILBOX_THREAD_LANE_NUM < 1) || (NS_MAILBOX_THREAD_BATCH_MAX < 1) || \
+    (NS_MAILBOX_THREAD_LANE_BUDGET < 1) || (NS_MAILBOX_THREAD_LANE_BUDGET > 255)
+#error "Invalid NS mailbox thread lane or batch configuration!"
+#endif
+
 /**
  * \brief Handling PSA client calls in a dedicated NS mailbox thread.
  *        This function constructs NS mailbox messages, transmits them to SPE
@@ -173,10 +379,22 @@ int32_t tfm_ns_mailbox_os_lock_init(void);
  */
 int32_t tfm_ns_mailbox_os_lock_acquire(void);
 
+/**
+ * \brief Acquire the multi-core lock for synchronizing PSA client call(s)
+ *        without blocking. Invoked by asynchronous PSA client calls.
+ *
+ * \return \ref MAILBOX_SUCCESS on success
+ * \return \ref MAILBOX_GENERIC_ERROR if the lock is not available
+ */
+int32_t tfm_ns_mailbox_os_lock_try_acquire(void);
+
 /**
  * \brief Release the multi-core lock for synchronizing PSA client call(s)
  *        The actual implementation depends on the non-secure use scenario.
  *
+ * \note The lock of an asynchronous PSA client call is released in the
+ *       mailbox IRQ handler, or with IRQ disabled.
+ *
  * \return \ref MAILBOX_SUCCESS on success
  * \return \ref MAILBOX_GENERIC_ERROR on error
  */
@@ -259,6 +477,33 @@ int32_t tfm_ns_mailbox_os_mq_send(void *mq_handle, const void *msg_ptr);
  *       queue, unless a fatal error occurs.
  */
 int32_t tfm_ns_mailbox_os_mq_receive(void *mq_handle, void *msg_ptr);
+
+/**
+ * \brief Select the request lane of the current task
+ *
+ * \note This function is implemented according to the NS OS task priorities
+ *       and use scenario. Lane 0 has the highest priority.
+ *
+ * \return The lane index, less than NS_MAILBOX_THREAD_LANE_NUM
+ */
+uint8_t tfm_ns_mailbox_os_mq_get_lane(void);
+
+/**
+ * \brief Wait for new PSA client call requests in NS mailbox thread.
+ *
+ * \note It must use a wake-up signal separate from the one of
+ *       \ref tfm_ns_mailbox_os_wait_reply(), which NS mailbox thread waits on
+ *       for a free mailbox slot.
+ */
+void tfm_ns_mailbox_os_wait_req(void);
+
+/**
+ * \brief Wake up NS mailbox thread sleeping in
+ *        \ref tfm_ns_mailbox_os_wait_req(), from task context.
+ *
+ * \param[in] task_handle       The handle to NS mailbox thread.
+ */
+void tfm_ns_mailbox_os_wake_req(const void *task_handle);
 #else /* TFM_MULTI_CORE_NS_OS */
 #define tfm_ns_mailbox_os_wait_reply()         do {} while (0)
 
@@ -274,6 +519,11 @@ static inline int32_t tfm_ns_mailbox_os_lock_acquire(void)
     return MAILBOX_SUCCESS;
 }
 
+static inline int32_t tfm_ns_mailbox_os_lock_try_acquire(void)
+{
+    return MAILBOX_SUCCESS;
+}
+
 static inline int32_t tfm_ns_mailbox_os_lock_release(void)
 {
     return MAILBOX_SUCCESS;
@@ -310,8 +560,21 @@ int32_t tfm_ns_mailbox_tx_stats_reinit(void);
  * \brief Update the statistics result of NSPE mailbox message transmission.
  *
  * \note This function is only available when multi-core tests are enabled.
+ *
+ * \param[in] nr_used_slots     The number of NSPE mailbox queue slots in use
+ *                              when the message is submitted.
  */
-void tfm_ns_mailbox_tx_stats_update(void);
+void tfm_ns_mailbox_tx_stats_update(uint8_t nr_used_slots);
+
+/**
+ * \brief Count a notification between NSPE mailbox and SPE mailbox.
+ *
+ * \note This function is only available when multi-core tests are enabled.
+ *
+ * \param[in] is_tx             True if the notification is sent to SPE, false
+ *                              if it is received from SPE.
+ */
+void tfm_ns_mailbox_notify_stats_update(bool is_tx);
 
 /**
  * \brief Calculate the average number of used NS mailbox queue slots each time
@@ -326,8 +589,94 @@ void tfm_ns_mailbox_tx_stats_update(void);
  * \return Return the calculation result.
  */
 void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res);
+
+/**
+ * \brief Calculate the average number of notifications sent to and received
+ *        from SPE per NS mailbox message, which are recorded in NS mailbox
+ *        statistics module.
+ *
+ * \note This function is only available when multi-core tests are enabled.
+ *
+ * \param[in] stats_res         The buffer to be written with
+ *                              \ref ns_mailbox_notify_stats_res_t.
+ */
+void tfm_ns_mailbox_stats_avg_notify(
+                               struct ns_mailbox_notify_stats_res_t *stats_res);
 #endif
 
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+/**
+ * \brief Get the value of a free-running counter, used to measure the round
+ *        trip latency of mailbox messages.
+ *
+ * \note The implementation depends on platform specific hardware.
+ *
+ * \return The counter value. It wraps around at 32 bits.
+ */
+uint32_t tfm_ns_mailbox_hal_get_timestamp(void);
+
+/**
+ * \brief Initialize NSPE mailbox statistics. Invoked by
+ *        \ref tfm_ns_mailbox_init().
+ *
+ * \param[in] ns_queue          The NSPE mailbox queue holding the statistics.
+ */
+void tfm_ns_mailbox_stats_init(struct ns_mailbox_queue_t *ns_queue);
+
+/**
+ * \brief Count a mailbox message submitted to SPE. Called before the message
+ *        is passed to SPE.
+ *
+ * \param[in] idx               The NSPE mailbox queue slot of the message.
+ * \param[in] call_type         PSA client call type
+ * \param[in] nr_used_slots     The number of NSPE mailbox queue slots in use.
+ */
+void tfm_ns_mailbox_stats_tx(uint8_t idx, uint32_t call_type,
+                             uint8_t nr_used_slots);
+
+/**
+ * \brief Count a PSA client call which waits for or fails to get a free NSPE
+ *        mailbox queue slot.
+ */
+void tfm_ns_mailbox_stats_queue_full(void);
+
+/**
+ * \brief Count a notification sent to SPE.
+ */
+void tfm_ns_mailbox_stats_doorbell_tx(void);
+
+/**
+ * \brief Count a notification received from SPE. Called in the mailbox IRQ
+ *        handler.
+ */
+void tfm_ns_mailbox_stats_doorbell_rx(void);
+
+/**
+ * \brief Record the round trip latency of a replied mailbox message. Called by
+ *        the consumer of the completion ring.
+ *
+ * \param[in] idx               The NSPE mailbox queue slot of the message.
+ */
+void tfm_ns_mailbox_stats_reply(uint8_t idx);
+
+/**
+ * \brief Read the mailbox statistics collected by NSPE and SPE.
+ *
+ * \param[out] stats            The buffer to be written with the statistics.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_stats_read(struct mailbox_stats_t *stats);
+#else /* TFM_MULTI_CORE_MAILBOX_STATS */
+#define tfm_ns_mailbox_stats_init(ns_queue)                 do {} while (0)
+#define tfm_ns_mailbox_stats_tx(idx, call_type, nr_used)    do {} while (0)
+#define tfm_ns_mailbox_stats_queue_full()                   do {} while (0)
+#define tfm_ns_mailbox_stats_doorbell_tx()                  do {} while (0)
+#define tfm_ns_mailbox_stats_doorbell_rx()                  do {} while (0)
+#define tfm_ns_mailbox_stats_reply(idx)                     do {} while (0)
+#endif /* TFM_MULTI_CORE_MAILBOX_STATS */
+
 #ifdef TFM_MULTI_CORE_NS_OS
 /*
  * When NSPE mailbox only covers a single non-secure core, spinlock only
@@ -356,28 +705,44 @@ static inline void ns_mailbox_spin_unlock(void)
 #define ns_mailbox_spin_unlock() do {} while (0)
 #endif /* TFM_MULTI_CORE_NS_OS */
 
-/* The following inline functions configure non-secure mailbox queue status */
-static inline void clear_queue_slot_empty(struct ns_mailbox_queue_t *queue_ptr,
-                                          uint8_t idx)
+/*
+ * The free NSPE mailbox queue slots. It is kept in NSPE private memory, as only
+ * NSPE allocates and releases the slots. The callers serialize the accesses.
+ */
+struct ns_mailbox_free_slots_t {
+    uint8_t idx[NUM_MAILBOX_QUEUE_SLOT];    /* Stack of free slot indices */
+    uint8_t nr_free;                        /* Number of free slots */
+};
+
+static inline void ns_mailbox_free_slots_init(
+                                         struct ns_mailbox_free_slots_t *slots)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        queue_ptr->empty_slots &= ~(1UL << idx);
+    uint8_t idx;
+
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        slots->idx[idx] = idx;
     }
+    slots->nr_free = NUM_MAILBOX_QUEUE_SLOT;
 }
 
-static inline void set_queue_slot_pend(struct ns_mailbox_queue_t *queue_ptr,
-                                       uint8_t idx)
+/* Return NUM_MAILBOX_QUEUE_SLOT if there is no free slot */
+static inline uint8_t ns_mailbox_alloc_slot(
+                                         struct ns_mailbox_free_slots_t *slots)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        queue_ptr->pend_slots |= (1UL << idx);
+    if (!slots->nr_free) {
+        return NUM_MAILBOX_QUEUE_SLOT;
     }
+
+    return slots->idx[--slots->nr_free];
 }
 
-static inline void clear_queue_slot_all_replied(
-                                           struct ns_mailbox_queue_t *queue_ptr,
-                                           mailbox_queue_status_t status)
+static inline void ns_mailbox_free_slot(struct ns_mailbox_free_slots_t *slots,
+                                        uint8_t idx)
 {
-    queue_ptr->replied_slots &= ~status;
+    if ((idx < NUM_MAILBOX_QUEUE_SLOT) &&
+        (slots->nr_free < NUM_MAILBOX_QUEUE_SLOT)) {
+        slots->idx[slots->nr_free++] = idx;
+    }
 }
 
 #ifdef __cplusplus
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -205,6 +207,113 @@ size_t psa_skip(psa_handle_t msg_handle, uint32_t invec_idx, size_t num_bytes);
 void psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
                const void *buffer, size_t num_bytes);
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+/**
+ * \brief Map a client input vector for direct access by a Secure Partition RoT
+ *        Service.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] invec_idx         Index of input vector to map. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval A pointer to the input vector data.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector has length zero.
+ * \arg                           The input vector has already been mapped using
+ *                                psa_map_invec().
+ * \arg                           The input vector has already been accessed
+ *                                using psa_read() or psa_skip().
+ */
+const void *psa_map_invec(psa_handle_t msg_handle, uint32_t invec_idx);
+
+/**
+ * \brief Unmap a client input vector that was previously mapped using
+ *        psa_map_invec().
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] invec_idx         Index of input vector to unmap. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval void                 Success.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector has not been mapped by a
+ *                                call to psa_map_invec().
+ * \arg                           The input vector has already been unmapped by
+ *                                a call to psa_unmap_invec().
+ */
+void psa_unmap_invec(psa_handle_t msg_handle, uint32_t invec_idx);
+
+/**
+ * \brief Map a client output vector for direct access by a Secure Partition
+ *        RoT Service.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] outvec_idx        Index of output vector to map. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval A pointer to the output vector data.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector has length zero.
+ * \arg                           The output vector has already been mapped
+ *                                using psa_map_outvec().
+ * \arg                           The output vector has already been accessed
+ *                                using psa_write().
+ */
+void *psa_map_outvec(psa_handle_t msg_handle, uint32_t outvec_idx);
+
+/**
+ * \brief Unmap a client output vector that was previously mapped using
+ *        psa_map_outvec().
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] outvec_idx        Index of output vector to unmap. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ * \param[in] len               Number of bytes written to the output buffer.
+ *
+ * \retval void                 Success.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector has not been mapped by a
+ *                                call to psa_map_outvec().
+ * \arg                           The output vector has already been unmapped by
+ *                                a call to psa_unmap_outvec().
+ * \arg                           len is greater than the output vector size.
+ */
+void psa_unmap_outvec(psa_handle_t msg_handle, uint32_t outvec_idx,
+                      size_t len);
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+
 /**
  * \brief Complete handling of a specific message and unblock the client.
  *
@@ -14,6 +14,7 @@
 #include "psa/error.h"
 #include "static_checks.h"
 #include "tfm_api.h"
+#include "tfm_multi_core_api.h"
 #include "tfm_ns_mailbox.h"
 
 /*
@@ -119,6 +120,69 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
     return status;
 }
 
+#ifndef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+psa_status_t tfm_psa_call_async(psa_handle_t handle, int32_t type,
+                                const psa_invec *in_vec, size_t in_len,
+                                psa_outvec *out_vec, size_t out_len,
+                                tfm_psa_call_cb_t cb, void *cb_arg,
+                                uint32_t *token)
+{
+    struct psa_client_params_t params;
+    int32_t ret;
+
+    params.psa_call_params.handle = handle;
+    params.psa_call_params.type = type;
+    params.psa_call_params.in_vec = in_vec;
+    params.psa_call_params.in_len = in_len;
+    params.psa_call_params.out_vec = out_vec;
+    params.psa_call_params.out_len = out_len;
+
+    ret = tfm_ns_mailbox_client_call_async(MAILBOX_PSA_CALL, &params,
+                                           NON_SECURE_CLIENT_ID,
+                                           (tfm_ns_mailbox_cb_t)cb, cb_arg,
+                                           token);
+    switch (ret) {
+    case MAILBOX_SUCCESS:
+        return PSA_SUCCESS;
+    case MAILBOX_QUEUE_FULL:
+        return PSA_ERROR_CONNECTION_BUSY;
+    case MAILBOX_INVAL_PARAMS:
+        return PSA_ERROR_INVALID_ARGUMENT;
+    default:
+        return PSA_INTER_CORE_COMM_ERR;
+    }
+}
+
+bool tfm_psa_call_poll(uint32_t token, psa_status_t *status)
+{
+    int32_t ret;
+
+    ret = tfm_ns_mailbox_client_poll(token, (int32_t *)status);
+    if (ret == MAILBOX_NO_PEND_EVENT) {
+        return false;
+    }
+
+    if (ret != MAILBOX_SUCCESS) {
+        *status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    return true;
+}
+
+psa_status_t tfm_psa_call_wait(uint32_t token)
+{
+    psa_status_t status;
+    int32_t ret;
+
+    ret = tfm_ns_mailbox_client_wait(token, (int32_t *)&status);
+    if (ret != MAILBOX_SUCCESS) {
+        status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    return status;
+}
+#endif /* TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD */
+
 void psa_close(psa_handle_t handle)
 {
     struct psa_client_params_t params;
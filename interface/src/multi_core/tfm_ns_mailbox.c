@@ -14,14 +14,39 @@
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
-static int32_t mailbox_wait_reply(uint8_t idx);
+/* The free NSPE mailbox queue slots */
+static struct ns_mailbox_free_slots_t free_slots;
 
-static inline void set_queue_slot_empty(uint8_t idx)
-{
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        mailbox_queue_ptr->empty_slots |= (1UL << idx);
-    }
-}
+#ifdef TFM_MULTI_CORE_NS_OS
+/* Waiting tasks poll the completion ring instead of sleeping */
+static volatile bool is_polling = false;
+#define mailbox_is_polling()            (is_polling)
+#else
+/* NS bare metal environment always polls the completion ring */
+#define mailbox_is_polling()            (true)
+#endif
+
+/* The position of the sequence number in an asynchronous call token */
+#define ASYNC_TOKEN_SEQ_POS             8
+#define ASYNC_TOKEN_IDX_MASK            0xFFUL
+#define ASYNC_TOKEN_SEQ_MASK            (0xFFFFFFFFUL >> ASYNC_TOKEN_SEQ_POS)
+
+/*
+ * The completion context of a mailbox message. It is kept in NSPE private
+ * memory since SPE never touches it.
+ */
+struct mailbox_async_ctx_t {
+    tfm_ns_mailbox_cb_t cb;             /* Completion callback */
+    void                *cb_arg;        /* Argument of completion callback */
+    uint32_t            token;          /* 0 if not an asynchronous call */
+};
+
+static struct mailbox_async_ctx_t async_ctx[NUM_MAILBOX_QUEUE_SLOT];
+
+/* The sequence number of the latest asynchronous call */
+static uint32_t async_seq = 0;
+
+static int32_t mailbox_wait_reply(uint8_t idx);
 
 static inline void set_queue_slot_woken(uint8_t idx)
 {
@@ -46,76 +71,99 @@ static inline void clear_queue_slot_woken(uint8_t idx)
     }
 }
 
-#ifndef TFM_MULTI_CORE_NS_OS
-static inline void clear_queue_slot_replied(uint8_t idx)
+static uint8_t acquire_empty_slot(void)
+{
+    uint8_t idx;
+
+    ns_mailbox_spin_lock();
+    idx = ns_mailbox_alloc_slot(&free_slots);
+    ns_mailbox_spin_unlock();
+
+    return idx;
+}
+
+static void set_msg_owner(uint8_t idx, const void *owner)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        mailbox_queue_ptr->replied_slots &= ~(1UL << idx);
+        mailbox_queue_ptr->queue[idx].reply.owner = owner;
     }
 }
-#endif
 
-#ifndef TFM_MULTI_CORE_NS_OS
-static inline bool is_queue_slot_replied(uint8_t idx)
+/* Return a token which is never 0 */
+static uint32_t get_async_token(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        return mailbox_queue_ptr->replied_slots & (1UL << idx);
+    async_seq = (async_seq + 1) & ASYNC_TOKEN_SEQ_MASK;
+    if (!async_seq) {
+        async_seq = 1;
     }
 
-    return false;
+    return (async_seq << ASYNC_TOKEN_SEQ_POS) | idx;
 }
-#endif
 
-static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
+/* Return NUM_MAILBOX_QUEUE_SLOT if the token is invalid or stale */
+static uint8_t get_async_token_idx(uint32_t token)
 {
-    uint8_t idx;
-    mailbox_queue_status_t status;
-
-    ns_mailbox_spin_lock();
-    status = queue->empty_slots;
-    ns_mailbox_spin_unlock();
+    uint8_t idx = (uint8_t)(token & ASYNC_TOKEN_IDX_MASK);
 
-    if (!status) {
-        /* No empty slot */
+    if (!token || (idx >= NUM_MAILBOX_QUEUE_SLOT) ||
+        (async_ctx[idx].token != token)) {
         return NUM_MAILBOX_QUEUE_SLOT;
     }
 
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        if (status & (1 << idx)) {
-            break;
-        }
-    }
-
-    ns_mailbox_spin_lock();
-    clear_queue_slot_empty(queue, idx);
-    ns_mailbox_spin_unlock();
-
     return idx;
 }
 
-static void set_msg_owner(uint8_t idx, const void *owner)
+/*
+ * Release a slot after its reply is fetched. The caller must hold the spinlock,
+ * or run in the mailbox IRQ handler.
+ */
+static void mailbox_release_slot(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        mailbox_queue_ptr->queue[idx].reply.owner = owner;
+    bool is_async = (async_ctx[idx].token != 0);
+
+    /* Clear up the owner field */
+    set_msg_owner(idx, NULL);
+    clear_queue_slot_woken(idx);
+    async_ctx[idx].token = 0;
+    async_ctx[idx].cb = NULL;
+    /*
+     * Make sure that the slot is released after all the other status flags are
+     * re-initialized.
+     */
+    ns_mailbox_free_slot(&free_slots, idx);
+
+    /*
+     * An asynchronous call holds the NS OS lock until its reply is fetched.
+     * A synchronous call releases the lock by itself.
+     */
+    if (is_async) {
+        (void)tfm_ns_mailbox_os_lock_release();
     }
 }
 
+/*
+ * Transmit a request. ctx is NULL for a synchronous call. Otherwise, the token
+ * of the asynchronous call is written into it.
+ */
 static int32_t mailbox_tx_client_req(uint32_t call_type,
                                      const struct psa_client_params_t *params,
                                      int32_t client_id,
+                                     struct mailbox_async_ctx_t *ctx,
                                      uint8_t *slot_idx)
 {
     uint8_t idx;
     struct mailbox_msg_t *msg_ptr;
     const void *task_handle;
 
-    idx = acquire_empty_slot(mailbox_queue_ptr);
+    idx = acquire_empty_slot();
     if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+        tfm_ns_mailbox_stats_queue_full();
         return MAILBOX_QUEUE_FULL;
     }
 
 #ifdef TFM_MULTI_CORE_TEST
-    tfm_ns_mailbox_tx_stats_update();
+    tfm_ns_mailbox_tx_stats_update(NUM_MAILBOX_QUEUE_SLOT -
+                                   free_slots.nr_free);
 #endif
 
     /* Fill the mailbox message */
@@ -132,11 +180,31 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     task_handle = tfm_ns_mailbox_os_get_task_handle();
     set_msg_owner(idx, task_handle);
 
-    tfm_ns_mailbox_hal_enter_critical();
-    set_queue_slot_pend(mailbox_queue_ptr, idx);
-    tfm_ns_mailbox_hal_exit_critical();
+    tfm_ns_mailbox_stats_tx(idx, call_type,
+                            NUM_MAILBOX_QUEUE_SLOT - free_slots.nr_free);
+
+    /*
+     * The request ring never overflows since it has as many entries as the
+     * slots. The lock only serializes the NS tasks producing requests.
+     * The completion context is set up before the request is visible, as the
+     * reply can be handled as soon as the lock is released.
+     */
+    ns_mailbox_spin_lock();
+    if (ctx) {
+        ctx->token = get_async_token(idx);
+        async_ctx[idx] = *ctx;
+    }
+    mailbox_ring_push(&mailbox_queue_ptr->req_ring, idx);
+    ns_mailbox_spin_unlock();
 
-    tfm_ns_mailbox_hal_notify_peer();
+    /* SPE will see the request without notification if it is draining */
+    if (mailbox_ring_need_notify(&mailbox_queue_ptr->req_ring)) {
+        tfm_ns_mailbox_hal_notify_peer();
+        tfm_ns_mailbox_stats_doorbell_tx();
+#ifdef TFM_MULTI_CORE_TEST
+        tfm_ns_mailbox_notify_stats_update(true);
+#endif
+    }
 
     *slot_idx = idx;
 
@@ -147,16 +215,8 @@ static int32_t mailbox_rx_client_reply(uint8_t idx, int32_t *reply)
 {
     *reply = mailbox_queue_ptr->queue[idx].reply.return_val;
 
-    /* Clear up the owner field */
-    set_msg_owner(idx, NULL);
-
     ns_mailbox_spin_lock();
-    clear_queue_slot_woken(idx);
-    /*
-     * Make sure that the empty flag is set after all the other status flags are
-     * re-initialized.
-     */
-    set_queue_slot_empty(idx);
+    mailbox_release_slot(idx);
     ns_mailbox_spin_unlock();
 
     return MAILBOX_SUCCESS;
@@ -184,7 +244,8 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     }
 
     /* It requires SVCall if NS mailbox is put in privileged mode. */
-    ret = mailbox_tx_client_req(call_type, params, client_id, &slot_idx);
+    ret = mailbox_tx_client_req(call_type, params, client_id, NULL,
+                                &slot_idx);
     if (ret != MAILBOX_SUCCESS) {
         goto exit;
     }
@@ -205,90 +266,239 @@ exit:
     return ret;
 }
 
-#ifdef TFM_MULTI_CORE_NS_OS
-int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+int32_t tfm_ns_mailbox_client_call_async(uint32_t call_type,
+                                const struct psa_client_params_t *params,
+                                int32_t client_id,
+                                tfm_ns_mailbox_cb_t cb,
+                                void *cb_arg,
+                                uint32_t *token)
 {
-    uint8_t idx;
-    mailbox_queue_status_t replied_status;
+    struct mailbox_async_ctx_t ctx;
+    uint8_t slot_idx;
+    int32_t ret;
 
     if (!mailbox_queue_ptr) {
         return MAILBOX_INIT_ERROR;
     }
 
-    tfm_ns_mailbox_hal_enter_critical_isr();
-    replied_status = mailbox_queue_ptr->replied_slots;
-    clear_queue_slot_all_replied(mailbox_queue_ptr, replied_status);
-    tfm_ns_mailbox_hal_exit_critical_isr();
+    if (!params || (!cb && !token)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
 
-    if (!replied_status) {
-        return MAILBOX_NO_PEND_EVENT;
+    /*
+     * Asynchronous calls share the slot accounting of the synchronous ones, so
+     * that a synchronous call always gets a slot. The caller is not blocked.
+     */
+    if (tfm_ns_mailbox_os_lock_try_acquire() != MAILBOX_SUCCESS) {
+        tfm_ns_mailbox_stats_queue_full();
+        return MAILBOX_QUEUE_FULL;
     }
 
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        /*
-         * The reply has already received from SPE mailbox but
-         * the wake-up signal is not sent yet.
-         */
-        if (!(replied_status & (0x1UL << idx))) {
+    ctx.cb = cb;
+    ctx.cb_arg = cb_arg;
+
+    ret = mailbox_tx_client_req(call_type, params, client_id, &ctx,
+                                &slot_idx);
+    if (ret != MAILBOX_SUCCESS) {
+        (void)tfm_ns_mailbox_os_lock_release();
+        return ret;
+    }
+
+    if (token) {
+        *token = ctx.token;
+    }
+
+    return MAILBOX_SUCCESS;
+}
+
+/*
+ * Hand over the replied mailbox messages. The replies of the calls with a
+ * completion callback are delivered to the callback. The owners of the other
+ * messages are woken up.
+ * The caller must run in the mailbox IRQ handler or hold the spinlock, to be
+ * the only consumer of the completion ring.
+ */
+static int32_t mailbox_drain_replies(void)
+{
+    uint8_t idx;
+    int32_t ret = MAILBOX_NO_PEND_EVENT;
+    tfm_ns_mailbox_cb_t cb;
+    void *cb_arg;
+    int32_t reply;
+
+    while (mailbox_ring_pop(&mailbox_queue_ptr->cpl_ring, &idx) ==
+           MAILBOX_SUCCESS) {
+        if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+            continue;
+        }
+
+        ret = MAILBOX_SUCCESS;
+
+        tfm_ns_mailbox_stats_reply(idx);
+
+        cb = async_ctx[idx].cb;
+        if (cb) {
+            cb_arg = async_ctx[idx].cb_arg;
+            reply = mailbox_queue_ptr->queue[idx].reply.return_val;
+
+            mailbox_release_slot(idx);
+            cb(cb_arg, reply);
             continue;
         }
 
         /* Set woken-up flag */
-        tfm_ns_mailbox_hal_enter_critical_isr();
         set_queue_slot_woken(idx);
-        tfm_ns_mailbox_hal_exit_critical_isr();
 
         tfm_ns_mailbox_os_wake_task_isr(
                                      mailbox_queue_ptr->queue[idx].reply.owner);
+    }
+
+    return ret;
+}
+
+int32_t tfm_ns_mailbox_client_poll(uint32_t token, int32_t *reply)
+{
+    uint8_t idx;
+    int32_t ret = MAILBOX_NO_PEND_EVENT;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (!reply) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    ns_mailbox_spin_lock();
+
+    /* Otherwise the mailbox IRQ handler fetches the replies */
+    if (mailbox_is_polling()) {
+        (void)mailbox_drain_replies();
+    }
+
+    idx = get_async_token_idx(token);
+    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+        ret = MAILBOX_INVAL_PARAMS;
+    } else if (is_queue_slot_woken(idx)) {
+        *reply = mailbox_queue_ptr->queue[idx].reply.return_val;
+        mailbox_release_slot(idx);
+        ret = MAILBOX_SUCCESS;
+    }
+
+    ns_mailbox_spin_unlock();
+
+    return ret;
+}
+
+/* Sleep until a reply arrives, or fetch the replies in poll mode */
+static void mailbox_wait_reply_event(void)
+{
+    if (!mailbox_is_polling()) {
+        tfm_ns_mailbox_os_wait_reply();
+        return;
+    }
+
+    /* Drain the completion ring on behalf of the mailbox IRQ handler */
+    ns_mailbox_spin_lock();
+    (void)mailbox_drain_replies();
+    ns_mailbox_spin_unlock();
+}
+
+int32_t tfm_ns_mailbox_client_wait(uint32_t token, int32_t *reply)
+{
+    int32_t ret;
 
-        replied_status &= ~(0x1UL << idx);
-        if (!replied_status) {
+    while (1) {
+        ret = tfm_ns_mailbox_client_poll(token, reply);
+        if (ret != MAILBOX_NO_PEND_EVENT) {
             break;
         }
+
+        mailbox_wait_reply_event();
     }
 
-    return MAILBOX_SUCCESS;
+    return ret;
 }
 
-static inline bool mailbox_wait_reply_signal(uint8_t idx)
+#ifdef TFM_MULTI_CORE_NS_OS
+int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 {
-    bool is_set = false;
+    int32_t ret = MAILBOX_NO_PEND_EVENT;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    tfm_ns_mailbox_stats_doorbell_rx();
+#ifdef TFM_MULTI_CORE_TEST
+    tfm_ns_mailbox_notify_stats_update(false);
+#endif
+
+    /*
+     * SPE can skip the notification of replies pushed while the completion
+     * ring is drained. Drain it again if a reply arrives before SPE sees the
+     * notification enabled. The notification stays disabled in poll mode.
+     */
+    mailbox_ring_disable_notify(&mailbox_queue_ptr->cpl_ring);
+
+    do {
+        if (mailbox_drain_replies() == MAILBOX_SUCCESS) {
+            ret = MAILBOX_SUCCESS;
+        }
+    } while (!is_polling &&
+             !mailbox_ring_enable_notify(&mailbox_queue_ptr->cpl_ring));
+
+    return ret;
+}
+
+int32_t tfm_ns_mailbox_set_poll_mode(bool enable)
+{
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
 
     ns_mailbox_spin_lock();
 
-    if (is_queue_slot_woken(idx)) {
-        clear_queue_slot_woken(idx);
-        is_set = true;
+    is_polling = enable;
+
+    if (enable) {
+        mailbox_ring_disable_notify(&mailbox_queue_ptr->cpl_ring);
+    } else {
+        /* Wake up the owners of the replies which arrived without notice */
+        while (!mailbox_ring_enable_notify(&mailbox_queue_ptr->cpl_ring)) {
+            mailbox_ring_disable_notify(&mailbox_queue_ptr->cpl_ring);
+            (void)mailbox_drain_replies();
+        }
     }
 
     ns_mailbox_spin_unlock();
 
-    return is_set;
+    return MAILBOX_SUCCESS;
 }
-#else /* TFM_MULTI_CORE_NS_OS */
+#endif /* TFM_MULTI_CORE_NS_OS */
+
 static inline bool mailbox_wait_reply_signal(uint8_t idx)
 {
     bool is_set = false;
 
-    tfm_ns_mailbox_hal_enter_critical();
+    ns_mailbox_spin_lock();
 
-    if (is_queue_slot_replied(idx)) {
-        clear_queue_slot_replied(idx);
+    if (is_queue_slot_woken(idx)) {
+        clear_queue_slot_woken(idx);
         is_set = true;
     }
 
-    tfm_ns_mailbox_hal_exit_critical();
+    ns_mailbox_spin_unlock();
 
     return is_set;
 }
-#endif /* TFM_MULTI_CORE_NS_OS */
 
 static int32_t mailbox_wait_reply(uint8_t idx)
 {
     bool is_replied;
 
     while (1) {
-        tfm_ns_mailbox_os_wait_reply();
+        mailbox_wait_reply_event();
 
         /*
          * Woken up from sleep
@@ -325,11 +535,22 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 
     memset(queue, 0, sizeof(*queue));
 
-    /* Initialize empty bitmask */
-    queue->empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
-    queue->empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+    ns_mailbox_free_slots_init(&free_slots);
+    memset(async_ctx, 0, sizeof(async_ctx));
+
+#ifdef TFM_MULTI_CORE_NS_MAILBOX_ARENA
+    tfm_ns_mailbox_arena_export(queue);
+#endif
+
+#if !defined(TFM_MULTI_CORE_NS_OS) && !defined(TFM_PARTITION_PSA_PROXY)
+    /*
+     * Replies are polled. SPE needs not notify NSPE.
+     * PSA Proxy keeps the notifications to ring its doorbell.
+     */
+    mailbox_ring_disable_notify(&queue->cpl_ring);
+#endif
+
+    tfm_ns_mailbox_stats_init(queue);
 
     mailbox_queue_ptr = queue;
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * NSPE shared buffer arena. Buffers are allocated in whole blocks of
+ * MAILBOX_CACHE_LINE_SIZE bytes, so that a buffer never shares a cache line
+ * with another one.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tfm_ns_mailbox.h"
+
+#define ARENA_BLOCK_SIZE            MAILBOX_CACHE_LINE_SIZE
+#define ARENA_MAP_WORDS             ((NS_MAILBOX_ARENA_BLOCK_NUM + 31) / 32)
+
+#define ARENA_MAP_BIT(map, blk)     ((map)[(blk) / 32] & (1UL << ((blk) % 32)))
+#define ARENA_MAP_SET(map, blk)     ((map)[(blk) / 32] |= (1UL << ((blk) % 32)))
+#define ARENA_MAP_CLR(map, blk)     ((map)[(blk) / 32] &= ~(1UL << ((blk) % 32)))
+
+static uintptr_t arena_base = 0;
+static uint32_t arena_blocks = 0;
+
+/* Blocks in use */
+static uint32_t used_map[ARENA_MAP_WORDS];
+/* Blocks starting a buffer */
+static uint32_t start_map[ARENA_MAP_WORDS];
+
+int32_t tfm_ns_mailbox_arena_init(void *base, size_t size)
+{
+    uint32_t i;
+
+    if (!base || ((uintptr_t)base % ARENA_BLOCK_SIZE) ||
+        (size < ARENA_BLOCK_SIZE)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    arena_blocks = (uint32_t)(size / ARENA_BLOCK_SIZE);
+    if (arena_blocks > NS_MAILBOX_ARENA_BLOCK_NUM) {
+        arena_blocks = NS_MAILBOX_ARENA_BLOCK_NUM;
+    }
+    arena_base = (uintptr_t)base;
+
+    for (i = 0; i < ARENA_MAP_WORDS; i++) {
+        used_map[i] = 0;
+        start_map[i] = 0;
+    }
+
+    return MAILBOX_SUCCESS;
+}
+
+void tfm_ns_mailbox_arena_export(struct ns_mailbox_queue_t *queue)
+{
+    queue->arena_base = arena_base;
+    queue->arena_size = (size_t)arena_blocks * ARENA_BLOCK_SIZE;
+}
+
+void *tfm_ns_mailbox_alloc_buf(size_t size)
+{
+    uint32_t blk, run = 0, nr_blocks;
+    void *buf = NULL;
+
+    if (!size || !arena_blocks) {
+        return NULL;
+    }
+
+    if (size > (size_t)arena_blocks * ARENA_BLOCK_SIZE) {
+        return NULL;
+    }
+
+    nr_blocks = (uint32_t)((size + ARENA_BLOCK_SIZE - 1) / ARENA_BLOCK_SIZE);
+
+    ns_mailbox_spin_lock();
+
+    /* First fit */
+    for (blk = 0; blk < arena_blocks; blk++) {
+        if (ARENA_MAP_BIT(used_map, blk)) {
+            run = 0;
+            continue;
+        }
+
+        if (++run == nr_blocks) {
+            blk = blk + 1 - nr_blocks;
+            break;
+        }
+    }
+
+    if (run == nr_blocks) {
+        ARENA_MAP_SET(start_map, blk);
+        for (run = 0; run < nr_blocks; run++) {
+            ARENA_MAP_SET(used_map, blk + run);
+        }
+
+        buf = (void *)(arena_base + blk * ARENA_BLOCK_SIZE);
+    }
+
+    ns_mailbox_spin_unlock();
+
+    return buf;
+}
+
+void tfm_ns_mailbox_free_buf(void *buf)
+{
+    uintptr_t offset;
+    uint32_t blk;
+
+    if (!buf || ((uintptr_t)buf < arena_base)) {
+        return;
+    }
+
+    offset = (uintptr_t)buf - arena_base;
+    if ((offset % ARENA_BLOCK_SIZE) ||
+        (offset >= (uintptr_t)arena_blocks * ARENA_BLOCK_SIZE)) {
+        return;
+    }
+
+    blk = (uint32_t)(offset / ARENA_BLOCK_SIZE);
+
+    ns_mailbox_spin_lock();
+
+    /* Ignore a pointer which is not the start of a buffer */
+    if (ARENA_MAP_BIT(start_map, blk)) {
+        ARENA_MAP_CLR(start_map, blk);
+
+        /* Release the blocks until the next buffer or a free block */
+        do {
+            ARENA_MAP_CLR(used_map, blk);
+            blk++;
+        } while ((blk < arena_blocks) && ARENA_MAP_BIT(used_map, blk) &&
+                 !ARENA_MAP_BIT(start_map, blk));
+    }
+
+    ns_mailbox_spin_unlock();
+}
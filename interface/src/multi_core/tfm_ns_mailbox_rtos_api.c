@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -28,7 +30,23 @@
  */
 #define MAILBOX_THREAD_FLAG            0x5FCA0000
 
-#ifndef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/*
+ * Thread flag to wake up NS mailbox thread for new requests. It must not share
+ * any bit with MAILBOX_THREAD_FLAG.
+ */
+#define MAILBOX_REQ_THREAD_FLAG        0x000035A0
+#endif
+
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/*
+ * Tasks at or above this priority use the highest priority request lane. The
+ * default value is osPriorityHigh in CMSIS-RTOS2.
+ */
+#ifndef NS_MAILBOX_LANE_HIGH_PRIORITY
+#define NS_MAILBOX_LANE_HIGH_PRIORITY  40
+#endif
+#else
 #define MAX_SEMAPHORE_COUNT            NUM_MAILBOX_QUEUE_SLOT
 
 static void *ns_lock_handle = NULL;
@@ -90,6 +108,34 @@ int32_t tfm_ns_mailbox_os_mq_receive(void *mq_handle, void *msg_ptr)
 
     return MAILBOX_GENERIC_ERROR;
 }
+
+uint8_t tfm_ns_mailbox_os_mq_get_lane(void)
+{
+    uint32_t priority;
+
+    if (os_wrapper_thread_get_priority(os_wrapper_thread_get_handle(),
+                                       &priority) != OS_WRAPPER_SUCCESS) {
+        return NS_MAILBOX_THREAD_LANE_NUM - 1;
+    }
+
+    /* Other tasks share the lowest priority lane */
+    if (priority >= NS_MAILBOX_LANE_HIGH_PRIORITY) {
+        return 0;
+    }
+
+    return NS_MAILBOX_THREAD_LANE_NUM - 1;
+}
+
+void tfm_ns_mailbox_os_wait_req(void)
+{
+    os_wrapper_thread_wait_flag(MAILBOX_REQ_THREAD_FLAG,
+                                OS_WRAPPER_WAIT_FOREVER);
+}
+
+void tfm_ns_mailbox_os_wake_req(const void *task_handle)
+{
+    os_wrapper_thread_set_flag((void *)task_handle, MAILBOX_REQ_THREAD_FLAG);
+}
 #else /* TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD */
 int32_t tfm_ns_mailbox_os_lock_init(void)
 {
@@ -109,6 +155,12 @@ int32_t tfm_ns_mailbox_os_lock_acquire(void)
                                         OS_WRAPPER_WAIT_FOREVER);
 }
 
+int32_t tfm_ns_mailbox_os_lock_try_acquire(void)
+{
+    /* A zero timeout returns at once if the semaphore is not available */
+    return os_wrapper_semaphore_acquire(ns_lock_handle, 0);
+}
+
 int32_t tfm_ns_mailbox_os_lock_release(void)
 {
     return os_wrapper_semaphore_release(ns_lock_handle);
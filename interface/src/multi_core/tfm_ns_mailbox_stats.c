@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "tfm_ns_mailbox.h"
+
+static struct mailbox_ns_stats_t *ns_stats_ptr = NULL;
+
+static const struct mailbox_stats_t *stats_ptr = NULL;
+
+/* The time each slot is submitted. Kept in NSPE private memory. */
+static uint32_t tx_time[NUM_MAILBOX_QUEUE_SLOT];
+
+void tfm_ns_mailbox_stats_init(struct ns_mailbox_queue_t *ns_queue)
+{
+    if (!ns_queue) {
+        return;
+    }
+
+    memset(&ns_queue->stats.ns, 0, sizeof(ns_queue->stats.ns));
+
+    ns_stats_ptr = &ns_queue->stats.ns;
+    stats_ptr = &ns_queue->stats;
+}
+
+void tfm_ns_mailbox_stats_tx(uint8_t idx, uint32_t call_type,
+                             uint8_t nr_used_slots)
+{
+    if (!ns_stats_ptr || (idx >= NUM_MAILBOX_QUEUE_SLOT)) {
+        return;
+    }
+
+    ns_mailbox_spin_lock();
+
+    if ((call_type >= 1) && (call_type <= MAILBOX_STATS_CALL_TYPE_NUM)) {
+        ns_stats_ptr->nr_calls[call_type - 1]++;
+    }
+
+    if (nr_used_slots > ns_stats_ptr->max_used_slots) {
+        ns_stats_ptr->max_used_slots = nr_used_slots;
+    }
+
+    ns_mailbox_spin_unlock();
+
+    tx_time[idx] = tfm_ns_mailbox_hal_get_timestamp();
+}
+
+void tfm_ns_mailbox_stats_queue_full(void)
+{
+    if (!ns_stats_ptr) {
+        return;
+    }
+
+    ns_mailbox_spin_lock();
+    ns_stats_ptr->nr_queue_full++;
+    ns_mailbox_spin_unlock();
+}
+
+void tfm_ns_mailbox_stats_doorbell_tx(void)
+{
+    if (!ns_stats_ptr) {
+        return;
+    }
+
+    ns_mailbox_spin_lock();
+    ns_stats_ptr->nr_doorbell_tx++;
+    ns_mailbox_spin_unlock();
+}
+
+void tfm_ns_mailbox_stats_doorbell_rx(void)
+{
+    if (!ns_stats_ptr) {
+        return;
+    }
+
+    /* Only called in the mailbox IRQ handler */
+    ns_stats_ptr->nr_doorbell_rx++;
+}
+
+void tfm_ns_mailbox_stats_reply(uint8_t idx)
+{
+    if (!ns_stats_ptr || (idx >= NUM_MAILBOX_QUEUE_SLOT)) {
+        return;
+    }
+
+    /* The single consumer of the completion ring owns the histogram */
+    mailbox_stats_hist_add(ns_stats_ptr->rtt_hist,
+                           tfm_ns_mailbox_hal_get_timestamp() - tx_time[idx]);
+}
+
+int32_t tfm_ns_mailbox_stats_read(struct mailbox_stats_t *stats)
+{
+    if (!stats) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    if (!stats_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    memcpy(stats, stats_ptr, sizeof(*stats));
+
+    return MAILBOX_SUCCESS;
+}
@@ -1,10 +1,14 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <string.h>
+
 #include "tfm_ns_mailbox.h"
 
 static struct ns_mailbox_queue_t *stats_queue_ptr = NULL;
@@ -17,6 +21,8 @@ void tfm_ns_mailbox_tx_stats_init(struct ns_mailbox_queue_t *ns_queue)
 
     ns_queue->nr_tx = 0;
     ns_queue->nr_used_slots = 0;
+    ns_queue->nr_notify_tx = 0;
+    ns_queue->nr_notify_rx = 0;
 
     stats_queue_ptr = ns_queue;
 }
@@ -29,36 +35,38 @@ int32_t tfm_ns_mailbox_tx_stats_reinit(void)
 
     stats_queue_ptr->nr_tx = 0;
     stats_queue_ptr->nr_used_slots = 0;
+    stats_queue_ptr->nr_notify_tx = 0;
+    stats_queue_ptr->nr_notify_rx = 0;
 
     return MAILBOX_SUCCESS;
 }
 
-void tfm_ns_mailbox_tx_stats_update(void)
+void tfm_ns_mailbox_tx_stats_update(uint8_t nr_used_slots)
 {
-    mailbox_queue_status_t empty_status;
-    uint8_t idx, nr_empty = 0;
-
     if (!stats_queue_ptr) {
         return;
     }
 
     ns_mailbox_spin_lock();
-    /* Count the number of used slots when this tx arrives */
-    empty_status = stats_queue_ptr->empty_slots;
+    stats_queue_ptr->nr_used_slots += nr_used_slots;
+    stats_queue_ptr->nr_tx++;
     ns_mailbox_spin_unlock();
+}
 
-    if (empty_status) {
-        for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-            if (empty_status & (0x1UL << idx)) {
-                nr_empty++;
-            }
-        }
+void tfm_ns_mailbox_notify_stats_update(bool is_tx)
+{
+    if (!stats_queue_ptr) {
+        return;
     }
 
-    ns_mailbox_spin_lock();
-    stats_queue_ptr->nr_used_slots += (NUM_MAILBOX_QUEUE_SLOT - nr_empty);
-    stats_queue_ptr->nr_tx++;
-    ns_mailbox_spin_unlock();
+    /* Also called in the mailbox IRQ handler */
+    if (is_tx) {
+        ns_mailbox_spin_lock();
+        stats_queue_ptr->nr_notify_tx++;
+        ns_mailbox_spin_unlock();
+    } else {
+        stats_queue_ptr->nr_notify_rx++;
+    }
 }
 
 void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res)
@@ -76,3 +84,30 @@ void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res)
     nr_used_slots %= nr_tx;
     stats_res->avg_nr_slots_tenths = nr_used_slots * 10 / nr_tx;
 }
+
+void tfm_ns_mailbox_stats_avg_notify(
+                               struct ns_mailbox_notify_stats_res_t *stats_res)
+{
+    uint32_t nr_notify_tx, nr_notify_rx, nr_tx;
+
+    if (!stats_queue_ptr || !stats_res) {
+        return;
+    }
+
+    nr_notify_tx = stats_queue_ptr->nr_notify_tx;
+    nr_notify_rx = stats_queue_ptr->nr_notify_rx;
+    nr_tx = stats_queue_ptr->nr_tx;
+
+    if (!nr_tx) {
+        memset(stats_res, 0, sizeof(*stats_res));
+        return;
+    }
+
+    stats_res->avg_nr_tx = nr_notify_tx / nr_tx;
+    nr_notify_tx %= nr_tx;
+    stats_res->avg_nr_tx_tenths = nr_notify_tx * 10 / nr_tx;
+
+    stats_res->avg_nr_rx = nr_notify_rx / nr_tx;
+    nr_notify_rx %= nr_tx;
+    stats_res->avg_nr_rx_tenths = nr_notify_rx * 10 / nr_tx;
+}
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -41,8 +43,17 @@ struct ns_mailbox_req_t {
                                                    */
 };
 
-/* Message queue handle */
-static void *msgq_handle = NULL;
+/* Message queue handles of the request lanes. Lane 0 has the top priority. */
+static void *msgq_handle[NS_MAILBOX_THREAD_LANE_NUM];
+
+/* The number of requests sent to each lane but not received yet */
+static uint8_t nr_pending[NS_MAILBOX_THREAD_LANE_NUM];
+
+/*
+ * The number of requests served from other lanes in a row while a lane has
+ * pending requests
+ */
+static uint8_t nr_bypassed[NS_MAILBOX_THREAD_LANE_NUM];
 
 /* The handle of the dedicated NS mailbox thread. */
 static const void *ns_mailbox_thread_handle = NULL;
@@ -50,10 +61,11 @@ static const void *ns_mailbox_thread_handle = NULL;
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
-static inline void set_queue_slot_all_empty(mailbox_queue_status_t completed)
-{
-    mailbox_queue_ptr->empty_slots |= completed;
-}
+/* The free NSPE mailbox queue slots */
+static struct ns_mailbox_free_slots_t free_slots;
+
+/* Whether the NS mailbox thread is waiting for a free slot */
+static volatile bool is_full = false;
 
 static inline void set_queue_slot_woken(uint8_t idx)
 {
@@ -62,39 +74,60 @@ static inline void set_queue_slot_woken(uint8_t idx)
     }
 }
 
-static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
+/* Notify SPE of the requests submitted, unless SPE is draining the ring */
+static void mailbox_kick_peer(void)
+{
+    if (mailbox_ring_need_notify(&mailbox_queue_ptr->req_ring)) {
+        tfm_ns_mailbox_hal_notify_peer();
+        tfm_ns_mailbox_stats_doorbell_tx();
+#ifdef TFM_MULTI_CORE_TEST
+        tfm_ns_mailbox_notify_stats_update(true);
+#endif
+    }
+}
+
+static uint8_t acquire_empty_slot(void)
 {
     uint8_t idx;
-    mailbox_queue_status_t status;
 
     while (1) {
         ns_mailbox_spin_lock();
-        status = queue->empty_slots;
+        idx = ns_mailbox_alloc_slot(&free_slots);
         ns_mailbox_spin_unlock();
 
-        if (status) {
+        if (idx < NUM_MAILBOX_QUEUE_SLOT) {
             break;
         }
 
-        /* No empty slot */
-        queue->is_full = true;
-        /* DSB to make sure the thread sleeps after the flag is set */
+        tfm_ns_mailbox_stats_queue_full();
+        is_full = true;
+        /* DSB to make sure the flag is set before the slots are checked again */
         __DSB();
 
-        /* Wait for an empty slot released by a completed mailbox message */
-        tfm_ns_mailbox_os_wait_reply();
-        queue->is_full = false;
-    }
+        /*
+         * A slot released before the flag is set wakes up nobody. Check again
+         * before sleeping. A slot released after this check wakes up the
+         * thread.
+         */
+        ns_mailbox_spin_lock();
+        idx = ns_mailbox_alloc_slot(&free_slots);
+        ns_mailbox_spin_unlock();
 
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        if (status & (1 << idx)) {
+        if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+            is_full = false;
             break;
         }
-    }
 
-    ns_mailbox_spin_lock();
-    clear_queue_slot_empty(queue, idx);
-    ns_mailbox_spin_unlock();
+        /*
+         * No empty slot. Make sure that SPE sees the requests submitted in the
+         * current batch, otherwise no slot will be released.
+         */
+        mailbox_kick_peer();
+
+        /* Wait for an empty slot released by a completed mailbox message */
+        tfm_ns_mailbox_os_wait_reply();
+        is_full = false;
+    }
 
     return idx;
 }
@@ -106,13 +139,14 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
     struct mailbox_reply_t *reply_ptr;
     uint8_t idx = NUM_MAILBOX_QUEUE_SLOT;
 
-    idx = acquire_empty_slot(mailbox_queue_ptr);
+    idx = acquire_empty_slot();
     if (idx == NUM_MAILBOX_QUEUE_SLOT) {
         return MAILBOX_QUEUE_FULL;
     }
 
 #ifdef TFM_MULTI_CORE_TEST
-    tfm_ns_mailbox_tx_stats_update();
+    tfm_ns_mailbox_tx_stats_update(NUM_MAILBOX_QUEUE_SLOT -
+                                   free_slots.nr_free);
 #endif
 
     /* Fill the mailbox message */
@@ -121,6 +155,9 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
     memcpy(&msg_ptr->params, req->params_ptr, sizeof(msg_ptr->params));
     msg_ptr->client_id = req->client_id;
 
+    tfm_ns_mailbox_stats_tx(idx, req->call_type,
+                            NUM_MAILBOX_QUEUE_SLOT - free_slots.nr_free);
+
     /* Prepare the reply structure */
     reply_ptr = &mailbox_queue_ptr->queue[idx].reply;
     reply_ptr->owner = req->owner;
@@ -132,11 +169,12 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
      * from providing addresses of other applications or privileged area.
      */
 
-    tfm_ns_mailbox_hal_enter_critical();
-    set_queue_slot_pend(mailbox_queue_ptr, idx);
-    tfm_ns_mailbox_hal_exit_critical();
-
-    tfm_ns_mailbox_hal_notify_peer();
+    /*
+     * The NS mailbox thread is the only producer of the request ring. The ring
+     * never overflows since it has as many entries as the slots.
+     * SPE is notified once per batch of requests.
+     */
+    mailbox_ring_push(&mailbox_queue_ptr->req_ring, idx);
 
     if (slot_idx) {
         *slot_idx = idx;
@@ -179,6 +217,7 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
 {
     struct ns_mailbox_req_t req;
     uint8_t woken_flag = NOT_WOKEN;
+    uint8_t lane;
     int32_t ret;
 
     if (!mailbox_queue_ptr) {
@@ -196,19 +235,78 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     req.owner = tfm_ns_mailbox_os_get_task_handle();
     req.client_id = client_id;
 
-    ret = tfm_ns_mailbox_os_mq_send(msgq_handle, &req);
+    lane = tfm_ns_mailbox_os_mq_get_lane();
+    if (lane >= NS_MAILBOX_THREAD_LANE_NUM) {
+        lane = NS_MAILBOX_THREAD_LANE_NUM - 1;
+    }
+
+    ret = tfm_ns_mailbox_os_mq_send(msgq_handle[lane], &req);
     if (ret != MAILBOX_SUCCESS) {
         return ret;
     }
 
+    ns_mailbox_spin_lock();
+    nr_pending[lane]++;
+    ns_mailbox_spin_unlock();
+
+    if (ns_mailbox_thread_handle) {
+        tfm_ns_mailbox_os_wake_req(ns_mailbox_thread_handle);
+    }
+
     ret = mailbox_wait_reply(&req);
 
     return ret;
 }
 
+/*
+ * Return the highest priority lane with a pending request, or
+ * NS_MAILBOX_THREAD_LANE_NUM if there is none. A lane which has waited for
+ * NS_MAILBOX_THREAD_LANE_BUDGET requests of other lanes is served first, so
+ * that a busy high priority lane cannot starve the others. The request is
+ * accounted as received.
+ */
+static uint8_t mailbox_fetch_pending_lane(void)
+{
+    uint8_t lane, sel = NS_MAILBOX_THREAD_LANE_NUM;
+
+    ns_mailbox_spin_lock();
+
+    for (lane = 0; lane < NS_MAILBOX_THREAD_LANE_NUM; lane++) {
+        if (!nr_pending[lane]) {
+            continue;
+        }
+
+        if (sel == NS_MAILBOX_THREAD_LANE_NUM) {
+            sel = lane;
+        }
+
+        if (nr_bypassed[lane] >= NS_MAILBOX_THREAD_LANE_BUDGET) {
+            sel = lane;
+            break;
+        }
+    }
+
+    if (sel < NS_MAILBOX_THREAD_LANE_NUM) {
+        nr_pending[sel]--;
+        nr_bypassed[sel] = 0;
+
+        for (lane = 0; lane < NS_MAILBOX_THREAD_LANE_NUM; lane++) {
+            if ((lane != sel) && nr_pending[lane] &&
+                (nr_bypassed[lane] < NS_MAILBOX_THREAD_LANE_BUDGET)) {
+                nr_bypassed[lane]++;
+            }
+        }
+    }
+
+    ns_mailbox_spin_unlock();
+
+    return sel;
+}
+
 void tfm_ns_mailbox_thread_runner(void *args)
 {
     struct ns_mailbox_req_t req;
+    uint8_t lane, nr_batch;
     int32_t ret;
 
     (void)args;
@@ -216,52 +314,67 @@ void tfm_ns_mailbox_thread_runner(void *args)
     ns_mailbox_thread_handle = tfm_ns_mailbox_os_get_task_handle();
 
     while (1) {
-        ret = tfm_ns_mailbox_os_mq_receive(msgq_handle, &req);
-        if (ret != MAILBOX_SUCCESS) {
-            continue;
-        }
+        nr_batch = 0;
 
         /*
-         * Invalid client address. However, the pointer was already
-         * checked previously and therefore just simply ignore this
-         * client call request.
+         * Submit the pending requests, higher priority lanes first, and notify
+         * SPE once for the whole batch.
          */
-        if (!req.params_ptr || !req.reply || !req.woken_flag) {
-            continue;
+        while (nr_batch < NS_MAILBOX_THREAD_BATCH_MAX) {
+            lane = mailbox_fetch_pending_lane();
+            if (lane >= NS_MAILBOX_THREAD_LANE_NUM) {
+                break;
+            }
+
+            /* The request is already in the queue. It won't block. */
+            ret = tfm_ns_mailbox_os_mq_receive(msgq_handle[lane], &req);
+            if (ret != MAILBOX_SUCCESS) {
+                continue;
+            }
+
+            /*
+             * Invalid client address. However, the pointer was already
+             * checked previously and therefore just simply ignore this
+             * client call request.
+             */
+            if (!req.params_ptr || !req.reply || !req.woken_flag) {
+                continue;
+            }
+
+            if (mailbox_tx_client_call_msg(&req, NULL) == MAILBOX_SUCCESS) {
+                nr_batch++;
+            }
         }
 
-        mailbox_tx_client_call_msg(&req, NULL);
+        if (nr_batch) {
+            mailbox_kick_peer();
+        } else {
+            /*
+             * Wait for new requests. The wake-up signal is separate from the
+             * one of replies and free slots, so that neither consumes the
+             * other.
+             */
+            tfm_ns_mailbox_os_wait_req();
+        }
     }
 }
 
-int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+/* Complete the replied mailbox messages. Called in the mailbox IRQ handler. */
+static int32_t mailbox_drain_replies(void)
 {
     uint8_t idx;
     const void *task_handle;
-    mailbox_queue_status_t replied_status, complete_slots = 0x0;
+    int32_t ret = MAILBOX_NO_PEND_EVENT;
 
-    if (!mailbox_queue_ptr) {
-        return MAILBOX_INIT_ERROR;
-    }
-
-    tfm_ns_mailbox_hal_enter_critical_isr();
-    replied_status = mailbox_queue_ptr->replied_slots;
-    clear_queue_slot_all_replied(mailbox_queue_ptr, replied_status);
-    tfm_ns_mailbox_hal_exit_critical_isr();
-
-    if (!replied_status) {
-        return MAILBOX_NO_PEND_EVENT;
-    }
-
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        /*
-         * The reply has already received from SPE mailbox but
-         * the wake-up signal is not sent yet.
-         */
-        if (!(replied_status & (0x1UL << idx))) {
+    /* This IRQ handler is the only consumer of the completion ring */
+    while (mailbox_ring_pop(&mailbox_queue_ptr->cpl_ring, &idx) ==
+           MAILBOX_SUCCESS) {
+        if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
             continue;
         }
 
+        tfm_ns_mailbox_stats_reply(idx);
+
         /*
          * Write back the return result.
          * When TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD is enabled, a reply is
@@ -280,21 +393,53 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
             tfm_ns_mailbox_os_wake_task_isr(task_handle);
         }
 
-        complete_slots |= (1UL << idx);
+        /*
+         * The NS mailbox thread masks IRQ while it allocates a slot, so the
+         * slot can be released here without a lock.
+         */
+        ns_mailbox_free_slot(&free_slots, idx);
 
-        replied_status &= ~(0x1UL << idx);
-        if (!replied_status) {
-            break;
-        }
+        ret = MAILBOX_SUCCESS;
+    }
+
+    return ret;
+}
+
+int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+{
+    int32_t ret = MAILBOX_NO_PEND_EVENT;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
     }
 
-    set_queue_slot_all_empty(complete_slots);
+    tfm_ns_mailbox_stats_doorbell_rx();
+#ifdef TFM_MULTI_CORE_TEST
+    tfm_ns_mailbox_notify_stats_update(false);
+#endif
+
+    /*
+     * SPE can skip the notification of replies pushed while the completion
+     * ring is drained. Drain it again if a reply arrives before SPE sees the
+     * notification enabled.
+     */
+    mailbox_ring_disable_notify(&mailbox_queue_ptr->cpl_ring);
+
+    do {
+        if (mailbox_drain_replies() == MAILBOX_SUCCESS) {
+            ret = MAILBOX_SUCCESS;
+        }
+    } while (!mailbox_ring_enable_notify(&mailbox_queue_ptr->cpl_ring));
+
+    if (ret != MAILBOX_SUCCESS) {
+        return ret;
+    }
 
     /*
      * Wake up the NS mailbox thread in case it is waiting for
      * empty slots.
      */
-    if (mailbox_queue_ptr->is_full) {
+    if (is_full) {
         if (ns_mailbox_thread_handle) {
             tfm_ns_mailbox_os_wake_task_isr(ns_mailbox_thread_handle);
         }
@@ -305,10 +450,18 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 
 static inline int32_t mailbox_req_queue_init(uint8_t queue_depth)
 {
-    msgq_handle = tfm_ns_mailbox_os_mq_create(sizeof(struct ns_mailbox_req_t),
-                                              queue_depth);
-    if (!msgq_handle) {
-        return MAILBOX_GENERIC_ERROR;
+    uint8_t lane;
+
+    for (lane = 0; lane < NS_MAILBOX_THREAD_LANE_NUM; lane++) {
+        msgq_handle[lane] = tfm_ns_mailbox_os_mq_create(
+                                             sizeof(struct ns_mailbox_req_t),
+                                             queue_depth);
+        if (!msgq_handle[lane]) {
+            return MAILBOX_GENERIC_ERROR;
+        }
+
+        nr_pending[lane] = 0;
+        nr_bypassed[lane] = 0;
     }
 
     return MAILBOX_SUCCESS;
@@ -329,11 +482,13 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 
     memset(queue, 0, sizeof(*queue));
 
-    /* Initialize empty bitmask */
-    queue->empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
-    queue->empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+    ns_mailbox_free_slots_init(&free_slots);
+
+#ifdef TFM_MULTI_CORE_NS_MAILBOX_ARENA
+    tfm_ns_mailbox_arena_export(queue);
+#endif
+
+    tfm_ns_mailbox_stats_init(queue);
 
     mailbox_queue_ptr = queue;
 
@@ -29,3 +29,19 @@ __WEAK enum tfm_plat_err_t tfm_spm_hal_deep_sleep(void)
 {
     return TFM_PLAT_ERR_SUCCESS;
 }
+
+__WEAK uint32_t tfm_hal_get_timestamp(void)
+{
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return DWT->CYCCNT;
+#else
+    /* No cycle counter in this core */
+    return 0;
+#endif
+}
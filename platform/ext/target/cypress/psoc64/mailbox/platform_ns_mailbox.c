@@ -128,6 +128,20 @@ void tfm_ns_mailbox_hal_exit_critical_isr(void)
     Cy_IPC_Drv_LockRelease(ipc_struct, CY_IPC_NO_NOTIFICATION);
 }
 
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+uint32_t tfm_ns_mailbox_hal_get_timestamp(void)
+{
+    /* NSPE runs on the Cortex-M4 core, which has a cycle counter */
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return DWT->CYCCNT;
+}
+#endif
+
 static bool mailbox_clear_intr(void)
 {
     uint32_t status;
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +10,8 @@
 #ifndef __TFM_HAL_PLATFORM_H__
 #define __TFM_HAL_PLATFORM_H__
 
+#include <stddef.h>
+#include <stdint.h>
 #include "tfm_hal_defs.h"
 
 /**
@@ -47,4 +51,16 @@ int32_t tfm_hal_random_init(void);
  */
 int32_t tfm_hal_random_generate(uint8_t *rand, size_t size);
 
+/**
+ * \brief Get the value of a free-running counter, used to timestamp SPM trace
+ *        events.
+ *
+ * The default implementation returns the DWT cycle counter on cores which
+ * have one, and 0 otherwise. Platforms without a cycle counter can provide
+ * a timer based implementation.
+ *
+ * \return The counter value. It wraps around at 32 bits.
+ */
+uint32_t tfm_hal_get_timestamp(void);
+
 #endif /* __TFM_HAL_PLATFORM_H__ */
@@ -44,6 +44,12 @@ typedef enum {
     TFM_SVC_PSA_CLEAR,
     TFM_SVC_PSA_PANIC,
     TFM_SVC_PSA_LIFECYCLE,
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    TFM_SVC_PSA_MAP_INVEC,
+    TFM_SVC_PSA_UNMAP_INVEC,
+    TFM_SVC_PSA_MAP_OUTVEC,
+    TFM_SVC_PSA_UNMAP_OUTVEC,
+#endif
 #endif
 #if (TFM_SPM_LOG_LEVEL > TFM_SPM_LOG_LEVEL_SILENCE)
     TFM_SVC_OUTPUT_UNPRIV_STRING,
@@ -51,6 +57,13 @@ typedef enum {
     /* Secure Partition API for interrupt control */
     TFM_SVC_PSA_IRQ_ENABLE,
     TFM_SVC_PSA_IRQ_DISABLE,
+#ifdef TFM_PSA_API
+    TFM_SVC_IRQ_TAKE_PENDING,
+#endif
+#if defined(TFM_PSA_API) && defined(TFM_SPM_DEBUG_STATS)
+    /* SPM debug statistics */
+    TFM_SVC_SPM_GET_STATS,
+#endif
 
     TFM_SVC_PLATFORM_BASE = 50 /* leave room for additional Core handlers */
 } tfm_svc_number_t;
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -21,6 +23,83 @@ enum tfm_spm_request_type_t {
  */
 int32_t tfm_spm_request_reset_vote(void);
 
+#ifdef TFM_PSA_API
+/**
+ * \brief Acknowledge a coalesced interrupt, see "tfm_irq_coalesce" in the
+ *        partition manifest. Use it instead of psa_eoi() to learn how many
+ *        times the interrupt was asserted since the previous acknowledgement.
+ *
+ * \param[in] irq_signal        The interrupt signal to acknowledge.
+ *
+ * \return Number of interrupt assertions merged into the signal, 0 if the
+ *         signal is not asserted.
+ *
+ * \note It is a fatal error if irq_signal is not a coalesced interrupt signal
+ *       of the calling partition.
+ */
+uint32_t tfm_irq_take_pending(psa_signal_t irq_signal);
+#endif
+
+#if defined(TFM_PSA_API) && defined(TFM_SPM_DEBUG_STATS)
+enum tfm_spm_stats_type_t {
+    TFM_SPM_STATS_CONN_HANDLE_POOL,     /* struct tfm_spm_pool_stats_t */
+    TFM_SPM_STATS_MPU_UPDATE,           /* struct tfm_spm_mpu_stats_t  */
+    TFM_SPM_STATS_PARTITION,            /* struct tfm_spm_partition_stats_t */
+    TFM_SPM_STATS_LOG,                  /* Partition statistics to log */
+    TFM_SPM_STATS_MAILBOX,              /* struct mailbox_stats_t, needs
+                                         * TFM_MULTI_CORE_MAILBOX_STATS
+                                         */
+};
+
+/* Usage statistics of an SPM object pool */
+struct tfm_spm_pool_stats_t {
+    uint32_t chunk_count;               /* Number of objects in the pool  */
+    uint32_t in_use;                    /* Objects currently allocated    */
+    uint32_t high_water;                /* Maximum of in_use ever reached */
+    uint32_t exhausted;                 /* Allocations failed as empty    */
+};
+
+/*
+ * Partition boundary updates done by the scheduler in isolation level 3, zero
+ * in other levels. Read twice and divide the difference of 'updates' by the
+ * difference of 'timestamp' to get the reprogram rate.
+ */
+struct tfm_spm_mpu_stats_t {
+    uint32_t updates;                   /* Boundary programmed into MPU   */
+    uint32_t skipped;                   /* Boundary already programmed    */
+    uint32_t timestamp;                 /* tfm_hal_get_timestamp() value  */
+};
+
+/*
+ * Stack and CPU usage of a partition. Set 'partition_id' before reading the
+ * statistics. Stack usage is measured on a stack painted at boot, and is not
+ * measured (0) for the non-secure partition whose stack is in use at boot.
+ */
+struct tfm_spm_partition_stats_t {
+    int32_t partition_id;               /* Partition to read, set by caller */
+    uint32_t stack_size;                /* Size of the stack in bytes     */
+    uint32_t stack_used;                /* High-water mark of the stack   */
+    uint32_t run_count;                 /* Times the partition is resumed */
+    uint64_t run_time;                  /* tfm_hal_get_timestamp() ticks  */
+};
+
+/**
+ * \brief Read SPM debug statistics. Only PSA RoT partitions are allowed to
+ *        read the statistics.
+ *
+ * \param[in]  type          Statistics to read, \ref tfm_spm_stats_type_t
+ * \param[out] buf           Buffer to hold the statistics, not used for
+ *                           TFM_SPM_STATS_LOG
+ * \param[in]  len           Size of the buffer in bytes
+ *
+ * \retval TFM_SUCCESS                  Statistics are copied into buffer
+ * \retval TFM_ERROR_INVALID_PARAMETER  Unknown type or partition, or buffer
+ *                                      is invalid
+ * \retval TFM_ERROR_GENERIC            Caller is not a PSA RoT partition
+ */
+int32_t tfm_spm_get_stats(uint32_t type, void *buf, uint32_t len);
+#endif
+
 #ifndef TFM_PSA_API
 void tfm_enable_irq(psa_signal_t irq_signal);
 void tfm_disable_irq(psa_signal_t irq_signal);
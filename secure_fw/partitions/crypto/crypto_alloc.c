@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -36,6 +38,9 @@ struct tfm_crypto_operation_s {
         psa_mac_operation_t mac;          /*!< MAC operation context */
         psa_hash_operation_t hash;        /*!< Hash operation context */
         psa_key_derivation_operation_t key_deriv; /*!< Key derivation operation context */
+#ifdef TFM_CRYPTO_AEAD_MULTIPART_ENABLED
+        psa_aead_operation_t aead;        /*!< AEAD operation context */
+#endif
     } operation;
 };
 
@@ -68,6 +73,11 @@ static void memset_operation_context(uint32_t index)
     case TFM_CRYPTO_KEY_DERIVATION_OPERATION:
         mem_size = sizeof(psa_key_derivation_operation_t);
         break;
+#ifdef TFM_CRYPTO_AEAD_MULTIPART_ENABLED
+    case TFM_CRYPTO_AEAD_OPERATION:
+        mem_size = sizeof(psa_aead_operation_t);
+        break;
+#endif
     case TFM_CRYPTO_OPERATION_NONE:
     default:
         mem_size = 0;
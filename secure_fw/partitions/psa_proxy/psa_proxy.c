@@ -1,10 +1,13 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "psa/service.h"
@@ -15,9 +18,13 @@
 #include "tfm_ns_mailbox.h"
 #include "platform_multicore.h"
 #include "psa_proxy_shared_mem_mngr.h"
+#include "tfm_crypto_defs.h"
 
 #define NON_SECURE_CLIENT_ID            (-1)
 
+/* Input vector carrying the data of a multipart crypto update */
+#define CRYPTO_UPDATE_DATA_INVEC        (1)
+
 /* Maximum number of connections supported, should be platform/configuration
  * specific */
 #define SE_CONN_MAX_NUM                 (16)
@@ -43,33 +50,191 @@ static inline void deallocate_forward_handle(psa_handle_t *h)
     tfm_pool_free(forward_handle_pool, h);
 }
 
-static psa_status_t forward_psa_call_to_secure_enclave(const psa_msg_t *msg)
-{
-    psa_status_t status;
-    psa_handle_t *forward_handle_ptr = (psa_handle_t *)msg->rhandle;
+/* A PSA call forwarded to the Secure Enclave and not replied yet */
+struct forward_ctx_t {
+    bool in_use;
+    bool segmented;                     /* Input is streamed in segments */
+    psa_msg_t msg;
     struct psa_client_params_t params;
+    uint32_t token;                     /* Token of the mailbox call */
+};
+
+/* Each context uses the shared memory slot of the same index */
+static struct forward_ctx_t forward_ctx[PSA_PROXY_SHARED_MEM_SLOT_NUM];
+static uint32_t nr_in_flight = 0;
+
+static psa_status_t forward_params_to_secure_enclave(
+                                        struct forward_ctx_t *ctx)
+{
     int32_t ret;
 
-    params.psa_call_params.handle = *forward_handle_ptr;
-    params.psa_call_params.type = PSA_IPC_CALL;
+    /*
+     * There are at least as many mailbox slots as contexts, so the call
+     * cannot run out of them.
+     */
+    ret = tfm_ns_mailbox_client_call_async(MAILBOX_PSA_CALL, &ctx->params,
+                                           NON_SECURE_CLIENT_ID, NULL, NULL,
+                                           &ctx->token);
+    if (ret != MAILBOX_SUCCESS) {
+        return PSA_ERROR_COMMUNICATION_FAILURE;
+    }
 
-    status = psa_proxy_put_msg_into_shared_mem(msg, &params);
+    return PSA_SUCCESS;
+}
+
+/*
+ * Hash, MAC and AEAD additional data updates can be split into several
+ * updates of the same operation without changing the result.
+ */
+static bool is_segmentable_crypto_call(uint32_t slot_idx, const psa_msg_t *msg)
+{
+    const struct tfm_crypto_pack_iovec *iov;
+    size_t len = 0;
 
+    if (msg->in_size[CRYPTO_UPDATE_DATA_INVEC] == 0) {
+        return false;
+    }
+
+    iov = psa_proxy_get_shared_in_vec(slot_idx, 0, &len);
+    if ((iov == NULL) || (len != sizeof(struct tfm_crypto_pack_iovec))) {
+        return false;
+    }
+
+    return (iov->sfn_id == TFM_CRYPTO_HASH_UPDATE_SID) ||
+           (iov->sfn_id == TFM_CRYPTO_MAC_UPDATE_SID) ||
+           (iov->sfn_id == TFM_CRYPTO_AEAD_UPDATE_AD_SID);
+}
+
+/* Stream an input vector too large for the shared memory in segments */
+static psa_status_t put_segmented_psa_call(psa_signal_t signal,
+                                           uint32_t slot_idx,
+                                           struct forward_ctx_t *ctx)
+{
+    psa_status_t status;
+
+    if (signal != TFM_CRYPTO_SIGNAL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    status = psa_proxy_put_msg_head_into_shared_mem(slot_idx, &ctx->msg,
+                                                    CRYPTO_UPDATE_DATA_INVEC);
     if (status != PSA_SUCCESS) {
         return status;
     }
 
-    ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
-                                     NON_SECURE_CLIENT_ID, (int32_t *)&status);
-    if (ret != MAILBOX_SUCCESS) {
-        status = PSA_ERROR_COMMUNICATION_FAILURE;
+    if (!is_segmentable_crypto_call(slot_idx, &ctx->msg)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
 
+    (void)psa_proxy_put_next_segment_into_shared_mem(slot_idx, &ctx->msg,
+                                                     CRYPTO_UPDATE_DATA_INVEC,
+                                                     &ctx->params);
+    ctx->segmented = true;
+
+    return PSA_SUCCESS;
+}
+
+static void finish_forward_psa_call(uint32_t slot_idx, psa_status_t status)
+{
+    struct forward_ctx_t *ctx = &forward_ctx[slot_idx];
+
     if (status == PSA_SUCCESS) {
-        psa_proxy_write_back_results_from_shared_mem(msg);
+        psa_proxy_write_back_results_from_shared_mem(slot_idx, &ctx->msg);
     }
 
-    return status;
+    psa_proxy_release_msg_from_shared_mem(slot_idx, &ctx->msg);
+
+    psa_reply(ctx->msg.handle, status);
+
+    ctx->in_use = false;
+    nr_in_flight--;
+}
+
+/* The client is replied once the Secure Enclave completes the call */
+static void forward_psa_call_to_secure_enclave(psa_signal_t signal,
+                                               const psa_msg_t *msg)
+{
+    psa_status_t status;
+    psa_handle_t *forward_handle_ptr = (psa_handle_t *)msg->rhandle;
+    struct forward_ctx_t *ctx = NULL;
+    uint32_t slot_idx;
+
+    for (slot_idx = 0; slot_idx < PSA_PROXY_SHARED_MEM_SLOT_NUM; slot_idx++) {
+        if (!forward_ctx[slot_idx].in_use) {
+            ctx = &forward_ctx[slot_idx];
+            break;
+        }
+    }
+
+    /* Messages are only fetched while a context is free */
+    if (ctx == NULL) {
+        psa_panic();
+    }
+
+    ctx->in_use = true;
+    ctx->segmented = false;
+    ctx->msg = *msg;
+    ctx->params.psa_call_params.handle = *forward_handle_ptr;
+    ctx->params.psa_call_params.type = PSA_IPC_CALL;
+    nr_in_flight++;
+
+    status = psa_proxy_put_msg_into_shared_mem(slot_idx, &ctx->msg,
+                                               &ctx->params);
+    if (status == PSA_ERROR_INSUFFICIENT_MEMORY) {
+        status = put_segmented_psa_call(signal, slot_idx, ctx);
+    }
+
+    if (status == PSA_SUCCESS) {
+        status = forward_params_to_secure_enclave(ctx);
+    }
+
+    if (status != PSA_SUCCESS) {
+        finish_forward_psa_call(slot_idx, status);
+    }
+}
+
+/*
+ * Complete the forwarded calls replied by the Secure Enclave, or forward the
+ * next segment of a segmented call.
+ */
+static void poll_forwarded_psa_calls(void)
+{
+    struct forward_ctx_t *ctx;
+    psa_status_t status;
+    uint32_t slot_idx;
+    int32_t reply;
+    int32_t ret;
+
+    for (slot_idx = 0; slot_idx < PSA_PROXY_SHARED_MEM_SLOT_NUM; slot_idx++) {
+        ctx = &forward_ctx[slot_idx];
+        if (!ctx->in_use) {
+            continue;
+        }
+
+        ret = tfm_ns_mailbox_client_poll(ctx->token, &reply);
+        if (ret == MAILBOX_NO_PEND_EVENT) {
+            continue;
+        }
+
+        status = (ret == MAILBOX_SUCCESS) ? (psa_status_t)reply :
+                                            PSA_ERROR_COMMUNICATION_FAILURE;
+
+        /*
+         * A failed segment aborts the operation in the Secure Enclave, so the
+         * remaining segments are not sent.
+         */
+        if ((status == PSA_SUCCESS) && ctx->segmented &&
+            (psa_proxy_put_next_segment_into_shared_mem(slot_idx, &ctx->msg,
+                                                     CRYPTO_UPDATE_DATA_INVEC,
+                                                     &ctx->params) > 0)) {
+            status = forward_params_to_secure_enclave(ctx);
+            if (status == PSA_SUCCESS) {
+                continue;
+            }
+        }
+
+        finish_forward_psa_call(slot_idx, status);
+    }
 }
 
 static void psa_disconnect_from_secure_enclave(psa_msg_t *msg)
@@ -210,8 +375,7 @@ static void handle_signal(psa_signal_t signal)
         psa_reply(msg.handle, status);
         break;
     case PSA_IPC_CALL:
-        status = forward_psa_call_to_secure_enclave(&msg);
-        psa_reply(msg.handle, status);
+        forward_psa_call_to_secure_enclave(signal, &msg);
         break;
     case PSA_IPC_DISCONNECT:
         psa_disconnect_from_secure_enclave(&msg);
@@ -243,7 +407,9 @@ static psa_status_t psa_proxy_init(void)
 
 psa_status_t psa_proxy_sp_init(void)
 {
-    psa_signal_t signal;
+    psa_signal_t signals, signal;
+    psa_signal_t wait_mask;
+    uint32_t timeout;
     psa_status_t err;
 
     err = psa_proxy_init();
@@ -252,9 +418,44 @@ psa_status_t psa_proxy_sp_init(void)
     }
 
     while (1) {
-        /* Control is given back to SPM */
-        signal = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
-        handle_signal(signal);
+        /* New messages wait while all the slots are in use. */
+        if (nr_in_flight < PSA_PROXY_SHARED_MEM_SLOT_NUM) {
+            wait_mask = PSA_WAIT_ANY;
+        } else {
+            wait_mask = PSA_DOORBELL;
+        }
+
+        /*
+         * Control is given back to SPM until a message or a mailbox reply
+         * arrives. Without a doorbell rung by the platform on each reply, the
+         * mailbox is polled while any call is in flight.
+         */
+#ifdef PSA_PROXY_REPLY_DOORBELL
+        timeout = PSA_BLOCK;
+#else
+        timeout = (nr_in_flight == 0) ? PSA_BLOCK : PSA_POLL;
+#endif
+
+        signals = psa_wait(wait_mask, timeout);
+
+        /*
+         * Clear the doorbell before polling, so that a reply arriving during
+         * the poll rings it again.
+         */
+        if (signals & PSA_DOORBELL) {
+            psa_clear();
+            signals &= ~PSA_DOORBELL;
+        }
+
+        /* One message per signal, the others are fetched in later rounds */
+        while ((signals != 0) &&
+               (nr_in_flight < PSA_PROXY_SHARED_MEM_SLOT_NUM)) {
+            signal = signals & (~signals + 1);
+            signals &= ~signal;
+            handle_signal(signal);
+        }
+
+        poll_forwarded_psa_calls();
     }
 
     return PSA_SUCCESS;
@@ -1,10 +1,14 @@
 /*
  * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <stdbool.h>
+
 #include "psa_proxy_shared_mem_mngr.h"
 #include "platform_multicore.h"
 #include "region_defs.h"
@@ -19,19 +23,60 @@
 #ifdef PSA_PROXY_SHARED_MEMORY_SIZE
 #define SHARED_BUFFER_SIZE (PSA_PROXY_SHARED_MEMORY_SIZE - \
                            sizeof(struct ns_mailbox_queue_t) - \
-                           (sizeof(psa_invec) * PSA_MAX_IOVEC)- \
-                           (sizeof(psa_outvec) * PSA_MAX_IOVEC))
+                           (((sizeof(psa_invec) * PSA_MAX_IOVEC) + \
+                             (sizeof(psa_outvec) * PSA_MAX_IOVEC)) * \
+                            PSA_PROXY_SHARED_MEM_SLOT_NUM))
 #else
 #ifndef SHARED_BUFFER_SIZE
 #error "PSA_PROXY_SHARED_MEMORY_SIZE or SHARED_BUFFER_SIZE should be defined"
 #endif
 #endif
 
-struct shared_mem_t {
-    struct ns_mailbox_queue_t ns_mailbox_queue;
+/* The buffer is split evenly between the slots, in 8-byte multiples */
+#define SLOT_BUFFER_SIZE    ((SHARED_BUFFER_SIZE / \
+                              PSA_PROXY_SHARED_MEM_SLOT_NUM) & ~(size_t)0x7)
+
+#ifdef PSA_PROXY_DIRECT_IOVEC
+#ifndef PSA_FRAMEWORK_HAS_MM_IOVEC
+#error "PSA_PROXY_DIRECT_IOVEC requires PSA_FRAMEWORK_HAS_MM_IOVEC"
+#endif
+
+/* Smaller vectors are cheaper to copy than to map */
+#ifndef PSA_PROXY_DIRECT_IOVEC_MIN_SIZE
+#define PSA_PROXY_DIRECT_IOVEC_MIN_SIZE     (256)
+#endif
+#endif /* PSA_PROXY_DIRECT_IOVEC */
+
+#ifdef PSA_PROXY_ADDR_TRANSLATION
+#define HOST_TO_SE_ADDR(addr)   translate_addr_from_host_to_se((void *)(addr))
+#else
+#define HOST_TO_SE_ADDR(addr)   ((void *)(addr))
+#endif
+
+/* The shared memory of a message in flight */
+struct shared_mem_slot_t {
     psa_invec in_vec[PSA_MAX_IOVEC];
     psa_outvec out_vec[PSA_MAX_IOVEC];
-    uint8_t buffer[SHARED_BUFFER_SIZE];
+    uint8_t buffer[SLOT_BUFFER_SIZE];
+};
+
+struct shared_mem_t {
+    struct ns_mailbox_queue_t ns_mailbox_queue;
+    struct shared_mem_slot_t slots[PSA_PROXY_SHARED_MEM_SLOT_NUM];
+};
+
+/* Host side view of a vector forwarded to the Secure Enclave */
+struct forward_vec_t {
+    void *base;
+    size_t len;
+    bool direct;            /* Mapped client vector instead of a copy */
+};
+
+/* Host side view of a shared memory slot */
+struct forward_slot_t {
+    uint32_t actual_size;   /* Bytes of the slot buffer in use */
+    struct forward_vec_t in_vec[PSA_MAX_IOVEC];
+    struct forward_vec_t out_vec[PSA_MAX_IOVEC];
 };
 
 #ifdef PSA_PROXY_SHARED_MEMORY_BASE
@@ -44,98 +89,152 @@ __attribute__((section("PSA_PROXY_SHARED_MEMORY_SECTION")))
 #endif
 struct shared_mem_t shared_mem;
 
-uint32_t shared_mem_buffer_actual_size = 0;
+static struct forward_slot_t forward_slots[PSA_PROXY_SHARED_MEM_SLOT_NUM];
 
-static psa_status_t write_input_param_into_shared_mem(uint32_t param_num,
-                                                      const psa_msg_t *msg)
+static inline bool is_direct_iovec(size_t len)
 {
-    const void *buff_input_ptr;
+#ifdef PSA_PROXY_DIRECT_IOVEC
+    return len >= PSA_PROXY_DIRECT_IOVEC_MIN_SIZE;
+#else
+    (void)len;
 
-    if (shared_mem_buffer_actual_size + msg->in_size[param_num] <=
-        SHARED_BUFFER_SIZE) {
-        buff_input_ptr = &(shared_mem.buffer[shared_mem_buffer_actual_size]);
+    return false;
+#endif
+}
 
-        psa_read(msg->handle,
-                 param_num,
-                 (void *) buff_input_ptr,
-                 msg->in_size[param_num]);
-        shared_mem_buffer_actual_size += msg->in_size[param_num];
+/*
+ * Check that the vectors to be copied fit into the buffer. The input vector
+ * skip_idx is left out, pass PSA_MAX_IOVEC to count all of them.
+ */
+static bool is_msg_fit_in_shared_mem(const psa_msg_t *msg, uint32_t skip_idx)
+{
+    size_t total = 0;
+    uint32_t i;
 
-        shared_mem.in_vec[param_num].base = buff_input_ptr;
-        shared_mem.in_vec[param_num].len = msg->in_size[param_num];
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        if ((i != skip_idx) && !is_direct_iovec(msg->in_size[i])) {
+            if (msg->in_size[i] > SLOT_BUFFER_SIZE - total) {
+                return false;
+            }
+            total += msg->in_size[i];
+        }
 
-        return PSA_SUCCESS;
-    } else {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
+        if (!is_direct_iovec(msg->out_size[i])) {
+            if (msg->out_size[i] > SLOT_BUFFER_SIZE - total) {
+                return false;
+            }
+            total += msg->out_size[i];
+        }
     }
+
+    return true;
 }
 
-static psa_status_t allocate_output_param_in_shared_mem(uint32_t param_num,
-                                                        const psa_msg_t *msg)
+static void write_input_param_into_shared_mem(uint32_t slot_idx,
+                                              uint32_t param_num,
+                                              const psa_msg_t *msg)
 {
-    void * buff_output_ptr;
-
-    if (shared_mem_buffer_actual_size + msg->out_size[param_num] <=
-        SHARED_BUFFER_SIZE) {
-        buff_output_ptr = &(shared_mem.buffer[shared_mem_buffer_actual_size]);
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
+    void *buff_input_ptr;
+
+#ifdef PSA_PROXY_DIRECT_IOVEC
+    if (is_direct_iovec(msg->in_size[param_num])) {
+        slot->in_vec[param_num].base =
+                            (void *)psa_map_invec(msg->handle, param_num);
+        slot->in_vec[param_num].len = msg->in_size[param_num];
+        slot->in_vec[param_num].direct = true;
+        return;
+    }
+#endif
 
-        shared_mem_buffer_actual_size += msg->out_size[param_num];
+    buff_input_ptr = &(shared_mem.slots[slot_idx].buffer[slot->actual_size]);
 
-        shared_mem.out_vec[param_num].base = buff_output_ptr;
-        shared_mem.out_vec[param_num].len = msg->out_size[param_num];
+    psa_read(msg->handle,
+             param_num,
+             buff_input_ptr,
+             msg->in_size[param_num]);
+    slot->actual_size += msg->in_size[param_num];
 
-        return PSA_SUCCESS;
-    } else {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
-    }
+    slot->in_vec[param_num].base = buff_input_ptr;
+    slot->in_vec[param_num].len = msg->in_size[param_num];
 }
 
-static void clear_shared_mem_buffer(void)
+static void allocate_output_param_in_shared_mem(uint32_t slot_idx,
+                                                uint32_t param_num,
+                                                const psa_msg_t *msg)
 {
-    int32_t i;
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
+    void *buff_output_ptr;
+
+#ifdef PSA_PROXY_DIRECT_IOVEC
+    if (is_direct_iovec(msg->out_size[param_num])) {
+        slot->out_vec[param_num].base =
+                            psa_map_outvec(msg->handle, param_num);
+        slot->out_vec[param_num].len = msg->out_size[param_num];
+        slot->out_vec[param_num].direct = true;
+        return;
+    }
+#endif
 
-    shared_mem_buffer_actual_size = 0;
+    buff_output_ptr = &(shared_mem.slots[slot_idx].buffer[slot->actual_size]);
 
-    for (i = 0; i < PSA_MAX_IOVEC; i++) {
-        shared_mem.in_vec[i].base = NULL;
-        shared_mem.in_vec[i].len = 0;
-        shared_mem.out_vec[i].base = NULL;
-        shared_mem.out_vec[i].len = 0;
-    }
+    slot->actual_size += msg->out_size[param_num];
+
+    slot->out_vec[param_num].base = buff_output_ptr;
+    slot->out_vec[param_num].len = msg->out_size[param_num];
 }
 
-#ifdef PSA_PROXY_ADDR_TRANSLATION
-static void translate_shared_mem_addrs_to_send_msg(
-        struct psa_client_params_t* forward_params)
+static void clear_shared_mem_buffer(uint32_t slot_idx)
 {
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
     int32_t i;
 
+    slot->actual_size = 0;
+
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
-        shared_mem.in_vec[i].base = translate_addr_from_host_to_se(
-                                            (void*)shared_mem.in_vec[i].base);
-        shared_mem.out_vec[i].base = translate_addr_from_host_to_se(
-                                            shared_mem.out_vec[i].base);
+        slot->in_vec[i].base = NULL;
+        slot->in_vec[i].len = 0;
+        slot->in_vec[i].direct = false;
+        slot->out_vec[i].base = NULL;
+        slot->out_vec[i].len = 0;
+        slot->out_vec[i].direct = false;
     }
-
-    forward_params->psa_call_params.in_vec = translate_addr_from_host_to_se(
-                                                        shared_mem.in_vec);
-    forward_params->psa_call_params.out_vec = translate_addr_from_host_to_se(
-                                                        shared_mem.out_vec);
 }
 
-static void translate_shared_mem_addrs_to_write_back_results(void)
+/*
+ * Build the vectors seen by the Secure Enclave. They are rebuilt before each
+ * forwarded call, as the Secure Enclave updates the output lengths in place.
+ */
+static void set_forward_params(uint32_t slot_idx,
+                               struct psa_client_params_t *forward_params)
 {
-    int32_t i;
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
+    struct shared_mem_slot_t *shared = &shared_mem.slots[slot_idx];
+    uint32_t i;
+    size_t in_vec_len = 0;
+    size_t out_vec_len = 0;
 
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
-        shared_mem.in_vec[i].base = translate_addr_from_se_to_host(
-                                            (void*)shared_mem.in_vec[i].base);
-        shared_mem.out_vec[i].base = translate_addr_from_se_to_host(
-                                            shared_mem.out_vec[i].base);
+        shared->in_vec[i].base = NULL;
+        shared->in_vec[i].len = slot->in_vec[i].len;
+        if (slot->in_vec[i].len > 0) {
+            shared->in_vec[i].base = HOST_TO_SE_ADDR(slot->in_vec[i].base);
+            in_vec_len = i + 1;
+        }
+
+        shared->out_vec[i].base = NULL;
+        shared->out_vec[i].len = slot->out_vec[i].len;
+        if (slot->out_vec[i].len > 0) {
+            shared->out_vec[i].base = HOST_TO_SE_ADDR(slot->out_vec[i].base);
+            out_vec_len = i + 1;
+        }
     }
 
+    forward_params->psa_call_params.in_vec = HOST_TO_SE_ADDR(shared->in_vec);
+    forward_params->psa_call_params.in_len = in_vec_len;
+    forward_params->psa_call_params.out_vec = HOST_TO_SE_ADDR(shared->out_vec);
+    forward_params->psa_call_params.out_len = out_vec_len;
 }
-#endif
 
 struct ns_mailbox_queue_t * psa_proxy_get_ns_mailbox_queue(void)
 {
@@ -143,62 +242,161 @@ struct ns_mailbox_queue_t * psa_proxy_get_ns_mailbox_queue(void)
 }
 
 psa_status_t psa_proxy_put_msg_into_shared_mem(
+        uint32_t slot_idx,
         const psa_msg_t* msg,
         struct psa_client_params_t* forward_params)
 {
-    psa_status_t status;
     uint32_t i;
-    size_t in_vec_len = 0;
-    size_t out_vec_len = 0;
 
-    clear_shared_mem_buffer();
+    if (slot_idx >= PSA_PROXY_SHARED_MEM_SLOT_NUM) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    clear_shared_mem_buffer(slot_idx);
+
+    /* Check before reading anything, so that the message can be segmented */
+    if (!is_msg_fit_in_shared_mem(msg, PSA_MAX_IOVEC)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
 
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
         if (msg->in_size[i] > 0) {
-            status = write_input_param_into_shared_mem(i, msg);
-            if ( status != PSA_SUCCESS ) {
-                return status;
-            }
-            in_vec_len = i + 1;
+            write_input_param_into_shared_mem(slot_idx, i, msg);
         }
     }
 
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
         if (msg->out_size[i] > 0) {
-            status = allocate_output_param_in_shared_mem(i, msg);
-            if ( status != PSA_SUCCESS ) {
-                return status;
-            }
-            out_vec_len = i + 1;
+            allocate_output_param_in_shared_mem(slot_idx, i, msg);
         }
     }
 
-    forward_params->psa_call_params.in_vec = shared_mem.in_vec;
-    forward_params->psa_call_params.in_len = in_vec_len;
-    forward_params->psa_call_params.out_vec = shared_mem.out_vec;
-    forward_params->psa_call_params.out_len = out_vec_len;
+    set_forward_params(slot_idx, forward_params);
 
-#ifdef PSA_PROXY_ADDR_TRANSLATION
-    translate_shared_mem_addrs_to_send_msg(forward_params);
-#endif
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_proxy_put_msg_head_into_shared_mem(uint32_t slot_idx,
+                                                    const psa_msg_t *msg,
+                                                    uint32_t seg_idx)
+{
+    uint32_t i;
+
+    if (slot_idx >= PSA_PROXY_SHARED_MEM_SLOT_NUM) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    clear_shared_mem_buffer(slot_idx);
+
+    if ((seg_idx >= PSA_MAX_IOVEC) || !is_msg_fit_in_shared_mem(msg, seg_idx)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        if ((i != seg_idx) && (msg->in_size[i] > 0)) {
+            write_input_param_into_shared_mem(slot_idx, i, msg);
+        }
+    }
+
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        if (msg->out_size[i] > 0) {
+            allocate_output_param_in_shared_mem(slot_idx, i, msg);
+        }
+    }
+
+    /* At least one byte of the segmented vector must fit */
+    if (forward_slots[slot_idx].actual_size >= SLOT_BUFFER_SIZE) {
+        psa_proxy_release_msg_from_shared_mem(slot_idx, msg);
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
 
     return PSA_SUCCESS;
 }
 
-void psa_proxy_write_back_results_from_shared_mem(const psa_msg_t* msg)
+const void *psa_proxy_get_shared_in_vec(uint32_t slot_idx, uint32_t idx,
+                                        size_t *len)
 {
+    if ((slot_idx >= PSA_PROXY_SHARED_MEM_SLOT_NUM) ||
+        (idx >= PSA_MAX_IOVEC) || forward_slots[slot_idx].in_vec[idx].direct) {
+        return NULL;
+    }
+
+    *len = forward_slots[slot_idx].in_vec[idx].len;
+
+    return forward_slots[slot_idx].in_vec[idx].base;
+}
+
+size_t psa_proxy_put_next_segment_into_shared_mem(
+        uint32_t slot_idx,
+        const psa_msg_t *msg,
+        uint32_t seg_idx,
+        struct psa_client_params_t *forward_params)
+{
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
+    void *buff_input_ptr;
+
+    buff_input_ptr = &(shared_mem.slots[slot_idx].buffer[slot->actual_size]);
+
+    /* psa_read() carries on from the end of the previous segment */
+    slot->in_vec[seg_idx].len = psa_read(msg->handle, seg_idx,
+                                         buff_input_ptr,
+                                         SLOT_BUFFER_SIZE - slot->actual_size);
+    slot->in_vec[seg_idx].base = buff_input_ptr;
+
+    set_forward_params(slot_idx, forward_params);
+
+    return slot->in_vec[seg_idx].len;
+}
+
+void psa_proxy_write_back_results_from_shared_mem(uint32_t slot_idx,
+                                                  const psa_msg_t* msg)
+{
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
     uint32_t i;
+    size_t len;
 
-#ifdef PSA_PROXY_ADDR_TRANSLATION
-    translate_shared_mem_addrs_to_write_back_results();
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        /* Written back by the Secure Enclave, do not trust it blindly */
+        len = shared_mem.slots[slot_idx].out_vec[i].len;
+        if (len > slot->out_vec[i].len) {
+            len = slot->out_vec[i].len;
+        }
+
+#ifdef PSA_PROXY_DIRECT_IOVEC
+        if (slot->out_vec[i].direct) {
+            psa_unmap_outvec(msg->handle, i, len);
+            slot->out_vec[i].direct = false;
+            continue;
+        }
 #endif
 
+        if (len > 0) {
+            psa_write(msg->handle, i, slot->out_vec[i].base, len);
+        }
+    }
+}
+
+void psa_proxy_release_msg_from_shared_mem(uint32_t slot_idx,
+                                           const psa_msg_t *msg)
+{
+#ifdef PSA_PROXY_DIRECT_IOVEC
+    struct forward_slot_t *slot = &forward_slots[slot_idx];
+    uint32_t i;
+
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
-       if (shared_mem.out_vec[i].len > 0) {
-           psa_write(msg->handle,
-                     i,
-                     shared_mem.out_vec[i].base,
-                     shared_mem.out_vec[i].len);
-       }
-   }
+        if (slot->in_vec[i].direct) {
+            psa_unmap_invec(msg->handle, i);
+            slot->in_vec[i].direct = false;
+        }
+
+        /* Results not written back, nothing has been produced */
+        if (slot->out_vec[i].direct) {
+            psa_unmap_outvec(msg->handle, i, 0);
+            slot->out_vec[i].direct = false;
+        }
+    }
+#else
+    (void)slot_idx;
+    (void)msg;
+#endif
 }
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,6 +18,19 @@
 extern "C" {
 #endif
 
+/*
+ * The number of messages which can be forwarded to the Secure Enclave at a
+ * time. Each of them has its own slot in the shared memory.
+ */
+#ifndef PSA_PROXY_SHARED_MEM_SLOT_NUM
+#define PSA_PROXY_SHARED_MEM_SLOT_NUM       NUM_MAILBOX_QUEUE_SLOT
+#endif
+
+#if (PSA_PROXY_SHARED_MEM_SLOT_NUM < 1) || \
+    (PSA_PROXY_SHARED_MEM_SLOT_NUM > NUM_MAILBOX_QUEUE_SLOT)
+#error "Invalid PSA_PROXY_SHARED_MEM_SLOT_NUM"
+#endif
+
 /**
  * \brief Returns the NS mailbox
  *
@@ -26,23 +41,87 @@ struct ns_mailbox_queue_t * psa_proxy_get_ns_mailbox_queue(void);
 /*!
  * \brief Puts message into the shared memory
  *
+ * \note With PSA_PROXY_DIRECT_IOVEC, large client vectors are mapped and
+ *       passed to the Secure Enclave in place instead of being copied.
+ *
+ * \param[in]  slot_idx         Shared memory slot of the message
  * \param[in]  msg              PSA message to be forwarded
  * \param[out] forward_params   PSA client parameters to be forwarded (pointers
  *                              of the shared input and output vectors shall be
  *                              written back to this structure.
  *
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The message does not fit into the
+ *                                        shared memory. Nothing has been read
+ *                                        from the client yet.
  * \return Returns values as specified by the \ref psa_status_t
  */
 psa_status_t psa_proxy_put_msg_into_shared_mem(
+        uint32_t slot_idx,
+        const psa_msg_t *msg,
+        struct psa_client_params_t *forward_params);
+
+/*!
+ * \brief Puts message into the shared memory, except for an input vector
+ *        which is forwarded in segments
+ *
+ * \param[in]  slot_idx         Shared memory slot of the message
+ * \param[in]  msg              PSA message to be forwarded
+ * \param[in]  seg_idx          Index of the input vector to be segmented
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t psa_proxy_put_msg_head_into_shared_mem(uint32_t slot_idx,
+                                                    const psa_msg_t *msg,
+                                                    uint32_t seg_idx);
+
+/*!
+ * \brief Returns the copy of an input vector in the shared memory
+ *
+ * \param[in]  slot_idx         Shared memory slot of the message
+ * \param[in]  idx              Index of the input vector
+ * \param[out] len              Length of the input vector
+ *
+ * \return Returns the Host address of the copy, or NULL if the vector has not
+ *         been copied into the shared memory.
+ */
+const void *psa_proxy_get_shared_in_vec(uint32_t slot_idx, uint32_t idx,
+                                        size_t *len);
+
+/*!
+ * \brief Puts the next segment of the segmented input vector into the shared
+ *        memory
+ *
+ * \param[in]  slot_idx         Shared memory slot of the message
+ * \param[in]  msg              PSA message to be forwarded
+ * \param[in]  seg_idx          Index of the segmented input vector
+ * \param[out] forward_params   PSA client parameters to be forwarded
+ *
+ * \return Returns the length of the segment, 0 if the vector has been fully
+ *         forwarded.
+ */
+size_t psa_proxy_put_next_segment_into_shared_mem(
+        uint32_t slot_idx,
         const psa_msg_t *msg,
+        uint32_t seg_idx,
         struct psa_client_params_t *forward_params);
 
 /*!
  * \brief Writes back the results of the forwarded PSA message
  *
+ * \param[in]  slot_idx  Shared memory slot of the message
+ * \param[in]  msg  Original PSA message was already forwarded
+ */
+void psa_proxy_write_back_results_from_shared_mem(uint32_t slot_idx,
+                                                  const psa_msg_t *msg);
+
+/*!
+ * \brief Releases the client vectors still mapped for a forwarded message
+ *
+ * \param[in]  slot_idx  Shared memory slot of the message
  * \param[in]  msg  Original PSA message was already forwarded
  */
-void psa_proxy_write_back_results_from_shared_mem(const psa_msg_t *msg);
+void psa_proxy_release_msg_from_shared_mem(uint32_t slot_idx,
+                                           const psa_msg_t *msg);
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -66,6 +68,21 @@ struct iovec_args_t {
                                         */
 };
 
+#ifdef TFM_SFN_LIGHTWEIGHT_CALL
+/**
+ * \brief Cycles spent in secure to secure partition calls, per call path.
+ *
+ * The time covers the whole call including the secure function, so the
+ * per-call overhead of the paths can be compared with a trivial service.
+ */
+struct tfm_sfn_call_stats_t {
+    uint32_t full_calls;        /*!< Calls through the full path */
+    uint64_t full_cycles;       /*!< Timestamp ticks spent in those calls */
+    uint32_t light_calls;       /*!< Calls through the lightweight path */
+    uint64_t light_cycles;      /*!< Timestamp ticks spent in those calls */
+};
+#endif
+
 /* The size of this struct must be multiple of 4 bytes as it is stacked to an
  * uint32_t[] array
  */
@@ -382,5 +399,14 @@ void tfm_spm_request_handler(const struct tfm_state_context_t *svc_ctx);
  */
 void tfm_spm_seal_psp_stacks(void);
 
+#ifdef TFM_SFN_LIGHTWEIGHT_CALL
+/**
+ * \brief                   Get the cycle statistics of secure to secure
+ *                          partition calls.
+ *
+ * \param[out] stats        Buffer to hold the statistics
+ */
+void tfm_spm_get_sfn_call_stats(struct tfm_sfn_call_stats_t *stats);
+#endif
 
 #endif /* __SPM_FUNC_H__ */
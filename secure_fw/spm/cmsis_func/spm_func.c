@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2017-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,6 +21,7 @@
 #include "tfm_peripherals_def.h"
 #include "tfm_secure_api.h"
 #include "tfm_spm_hal.h"
+#include "tfm_hal_platform.h"
 #include "tfm_core_trustzone.h"
 #include "spm_func.h"
 #include "region_defs.h"
@@ -49,6 +52,10 @@ struct iovec_params_t {
 #error Multi core is not supported by Function mode
 #endif
 
+#if defined(TFM_SFN_LIGHTWEIGHT_CALL) && (TFM_LVL != 1)
+#error TFM_SFN_LIGHTWEIGHT_CALL is only supported in isolation level 1
+#endif
+
 REGION_DECLARE_T(Image$$, TFM_SECURE_STACK, $$ZI$$Base, uint32_t);
 REGION_DECLARE_T(Image$$, TFM_SECURE_STACK, $$ZI$$Limit, struct iovec_args_t)[];
 
@@ -844,7 +851,7 @@ enum tfm_status_e tfm_spm_sfn_request_handler(
     return res;
 }
 
-int32_t tfm_spm_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr)
+static int32_t tfm_spm_sfn_request_full(struct tfm_sfn_req_s *desc_ptr)
 {
     enum tfm_status_e res;
     int32_t *args;
@@ -883,6 +890,153 @@ int32_t tfm_spm_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr)
     return (int32_t)res;
 }
 
+#ifdef TFM_SFN_LIGHTWEIGHT_CALL
+static struct tfm_sfn_call_stats_t sfn_call_stats;
+
+/**
+ * \brief Check whether a secure to secure partition call can take the
+ *        lightweight path.
+ *
+ * Both partitions have to be PSA RoT. In isolation level 1 they run privileged
+ * in the same isolation domain, so the callee can access everything the caller
+ * can, and checking or copying the iovecs on behalf of the caller gives no
+ * protection.
+ *
+ * \param[in] caller_partition_idx  Index of the calling partition
+ * \param[in] partition_idx         Index of the partition to be called
+ *
+ * \return true if the lightweight path can be used, false otherwise
+ */
+static bool is_lightweight_sfn_call(uint32_t caller_partition_idx,
+                                    uint32_t partition_idx)
+{
+    if ((tfm_secure_api_initializing) ||
+        (caller_partition_idx == SPM_INVALID_PARTITION_IDX) ||
+        (partition_idx == SPM_INVALID_PARTITION_IDX)) {
+        return false;
+    }
+
+    return (tfm_spm_partition_get_flags(caller_partition_idx) &
+            tfm_spm_partition_get_flags(partition_idx) &
+            SPM_PART_FLAG_PSA_ROT) != 0;
+}
+
+/**
+ * \brief Call a secure function on the lightweight path.
+ *
+ * The iovecs are passed to the secure function as the caller provided them,
+ * and the caller context is not stored. Only the partition states and the
+ * caller of the called partition are updated, so that non-reentrancy, IRQ
+ * handling and \ref tfm_core_get_caller_client_id work as on the full path.
+ *
+ * \param[in] desc_ptr       The secure function request descriptor
+ * \param[in] partition_idx  Index of the partition to be called
+ *
+ * \return The return value of the secure function, or an error code as in
+ *         \ref tfm_status_e if the iovec counts are invalid.
+ */
+static int32_t tfm_spm_sfn_request_lightweight(struct tfm_sfn_req_s *desc_ptr,
+                                               uint32_t partition_idx)
+{
+    uint32_t caller_partition_idx = desc_ptr->caller_part_idx;
+    int32_t *args = desc_ptr->args;
+    int32_t retVal;
+    enum tfm_status_e res;
+
+    if (desc_ptr->sfn == NULL) {
+        ERROR_MSG("Invalid service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    /* The secure function indexes the iovecs with the counts */
+    if ((args[1] < 0) || (args[3] < 0) ||
+        (args[1] > PSA_MAX_IOVEC) || (args[3] > PSA_MAX_IOVEC) ||
+        (args[1] + args[3] > PSA_MAX_IOVEC)) {
+        return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    __disable_irq();
+
+    res = check_partition_state(
+        tfm_spm_partition_get_runtime_data(partition_idx)->partition_state,
+        tfm_spm_partition_get_runtime_data(caller_partition_idx)->
+                                                              partition_state);
+    if (res != TFM_SUCCESS) {
+        __enable_irq();
+        ERROR_MSG("Failed to process service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    tfm_spm_partition_set_caller_partition_idx(partition_idx,
+                                               caller_partition_idx);
+    tfm_spm_partition_set_caller_client_id(partition_idx,
+                tfm_spm_partition_get_partition_id(caller_partition_idx));
+    tfm_spm_partition_set_state(caller_partition_idx,
+                                SPM_PARTITION_STATE_BLOCKED);
+    tfm_spm_partition_set_state(partition_idx, SPM_PARTITION_STATE_RUNNING);
+    tfm_secure_lock++;
+
+    __enable_irq();
+
+    retVal = desc_ptr->sfn(args[0], args[1], args[2], args[3]);
+
+    __disable_irq();
+
+    tfm_secure_lock--;
+    tfm_spm_partition_set_caller_partition_idx(partition_idx,
+                                               SPM_INVALID_PARTITION_IDX);
+    tfm_spm_partition_set_state(partition_idx, SPM_PARTITION_STATE_IDLE);
+    tfm_spm_partition_set_state(caller_partition_idx,
+                                SPM_PARTITION_STATE_RUNNING);
+
+    __enable_irq();
+
+    return retVal;
+}
+
+void tfm_spm_get_sfn_call_stats(struct tfm_sfn_call_stats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = sfn_call_stats;
+    }
+}
+#endif /* TFM_SFN_LIGHTWEIGHT_CALL */
+
+int32_t tfm_spm_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr)
+{
+#ifdef TFM_SFN_LIGHTWEIGHT_CALL
+    uint32_t start = tfm_hal_get_timestamp();
+    uint32_t partition_idx;
+    int32_t retVal;
+
+    if (desc_ptr == NULL) {
+        ERROR_MSG("Invalid service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    desc_ptr->caller_part_idx = tfm_spm_partition_get_running_partition_idx();
+    partition_idx = get_partition_idx(desc_ptr->sp_id);
+
+    /*
+     * The statistics are not updated atomically: a call from a preempting IRQ
+     * handler may get lost. They are meant for benchmarking only.
+     */
+    if (is_lightweight_sfn_call(desc_ptr->caller_part_idx, partition_idx)) {
+        retVal = tfm_spm_sfn_request_lightweight(desc_ptr, partition_idx);
+        sfn_call_stats.light_calls++;
+        sfn_call_stats.light_cycles += tfm_hal_get_timestamp() - start;
+    } else {
+        retVal = tfm_spm_sfn_request_full(desc_ptr);
+        sfn_call_stats.full_calls++;
+        sfn_call_stats.full_cycles += tfm_hal_get_timestamp() - start;
+    }
+
+    return retVal;
+#else
+    return tfm_spm_sfn_request_full(desc_ptr);
+#endif /* TFM_SFN_LIGHTWEIGHT_CALL */
+}
+
 int32_t tfm_spm_check_buffer_access(uint32_t  partition_idx,
                                     void     *start_addr,
                                     size_t    len,
@@ -31,6 +31,38 @@ int32_t tfm_spm_request_reset_vote(void)
     return tfm_spm_request((int32_t)TFM_SPM_REQUEST_RESET_VOTE);
 }
 
+__attribute__((naked))
+uint32_t tfm_irq_take_pending(psa_signal_t irq_signal)
+{
+#if !defined(__clang__)
+    /* naked parameter, suppress compiler warning */
+    (void)irq_signal;
+#endif
+
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_IRQ_TAKE_PENDING));
+}
+
+#ifdef TFM_SPM_DEBUG_STATS
+__attribute__((naked))
+int32_t tfm_spm_get_stats(uint32_t type, void *buf, uint32_t len)
+{
+#if !defined(__clang__)
+    /* naked parameters, suppress compiler warnings */
+    (void)type;
+    (void)buf;
+    (void)len;
+#endif
+
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_SPM_GET_STATS));
+}
+#endif
+
 static void tfm_arch_init_state_ctx(struct tfm_state_context_t *p_stat_ctx,
                                     void *param, uintptr_t pfn)
 {
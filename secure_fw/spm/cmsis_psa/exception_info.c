@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2021, Nordic Semiconductor ASA. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -233,5 +235,8 @@ void store_and_dump_context(uint32_t LR_in, uint32_t MSP_in, uint32_t PSP_in,
 #endif
 #endif
 
+    /* Output the buffered log first, the fault may not return */
+    spm_log_drain();
     dump_error(exception_type);
+    spm_log_drain();
 }
@@ -23,6 +23,7 @@
 #include "tfm_memory_utils.h"
 #include "tfm_hal_defs.h"
 #include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
 #include "spm_ipc.h"
 #include "tfm_peripherals_def.h"
 #include "tfm_core_utils.h"
@@ -30,6 +31,11 @@
 #include "tfm_core_trustzone.h"
 #include "lists.h"
 #include "tfm_pools.h"
+#include "tfm_spm_log.h"
+#include "tfm_spm_trace.h"
+#ifdef TFM_MULTI_CORE_TOPOLOGY
+#include "tfm_spe_mailbox.h"
+#endif
 #include "region.h"
 #include "region_defs.h"
 #include "spm_partition_defs.h"
@@ -45,6 +51,9 @@ TFM_POOL_DECLARE(conn_handle_pool, sizeof(struct tfm_conn_handle_t),
 
 void tfm_set_irq_signal(uint32_t partition_id, psa_signal_t signal,
                         uint32_t irq_line);
+void tfm_set_coalesced_irq_signal(uint32_t partition_id, psa_signal_t signal,
+                                  uint32_t irq_line,
+                                  volatile uint32_t *p_pending);
 
 #include "tfm_secure_irq_handlers_ipc.inc"
 
@@ -254,14 +263,26 @@ struct tfm_msg_body_t *tfm_spm_get_msg_by_signal(struct partition_t *partition,
     BI_LIST_FOR_EACH(node, head) {
         tmp_msg = TFM_GET_CONTAINER_PTR(node, struct tfm_msg_body_t, msg_node);
         if (tmp_msg->service->service_db->signal == signal && msg) {
-            return msg;
+            break;
         } else if (tmp_msg->service->service_db->signal == signal) {
             msg = tmp_msg;
             BI_LIST_REMOVE_NODE(node);
         }
     }
 
-    partition->signals_asserted &= ~signal;
+    if (node == head) {
+        partition->signals_asserted &= ~signal;
+    }
+
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+    /*
+     * The client blocks until the message is replied to. Not linked in the
+     * loop above, which walks on from the removed node.
+     */
+    if (msg) {
+        BI_LIST_INSERT_BEFORE(&partition->serving_list, &msg->msg_node);
+    }
+#endif
 
     return msg;
 }
@@ -558,11 +579,53 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
     }
 }
 
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+/* Highest priority among the owners of the messages in the list */
+static uint32_t get_clients_priority(struct bi_list_node_t *head,
+                                     uint32_t prior)
+{
+    struct bi_list_node_t *node;
+    struct tfm_msg_body_t *msg;
+    const struct tfm_core_thread_t *pth;
+
+    BI_LIST_FOR_EACH(node, head) {
+        msg = TFM_GET_CONTAINER_PTR(node, struct tfm_msg_body_t, msg_node);
+        pth = msg->ack_evnt.owner;
+        if (pth && pth->prior < prior) {
+            prior = pth->prior;
+        }
+    }
+
+    return prior;
+}
+
+void tfm_spm_drop_inherited_priority(struct partition_t *partition,
+                                     struct tfm_msg_body_t *msg)
+{
+    uint32_t prior = partition->p_static->priority;
+
+    /* Re-init the node, a later call on the connection inserts it again */
+    BI_LIST_REMOVE_NODE(&msg->msg_node);
+    BI_LIST_INIT_NODE(&msg->msg_node);
+
+    /* The clients of the queued and the got messages are still blocked */
+    prior = get_clients_priority(&partition->msg_list, prior);
+    prior = get_clients_priority(&partition->serving_list, prior);
+
+    if (prior != partition->sp_thread.prior) {
+        tfm_core_thrd_change_priority(&partition->sp_thread, prior);
+    }
+}
+#endif /* TFM_SPM_PRIORITY_INHERITANCE */
+
 void tfm_spm_send_event(struct tfm_spm_service_t *service,
                         struct tfm_msg_body_t *msg)
 {
     struct partition_t *partition = NULL;
     psa_signal_t signal = 0;
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+    const struct tfm_core_thread_t *p_client;
+#endif
 
     if (!msg || !service || !service->service_db || !service->partition) {
         tfm_core_panic();
@@ -571,9 +634,28 @@ void tfm_spm_send_event(struct tfm_spm_service_t *service,
     partition = service->partition;
     signal = service->service_db->signal;
 
+    SPM_TRACE(msg->msg.type == PSA_IPC_CONNECT ? TFM_SPM_TRACE_EVT_CONNECT :
+              msg->msg.type == PSA_IPC_DISCONNECT ? TFM_SPM_TRACE_EVT_CLOSE :
+                                                    TFM_SPM_TRACE_EVT_CALL,
+              service->service_db->sid, msg->msg.client_id);
+
     /* Add message to partition message list tail */
     BI_LIST_INSERT_BEFORE(&partition->msg_list, &msg->msg_node);
 
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+    /*
+     * Let the service run at least at the priority of the blocked caller.
+     * Only raise it, the service may be serving a higher priority client.
+     */
+    if (!is_tfm_rpc_msg(msg)) {
+        p_client = tfm_core_thrd_get_curr();
+        if (p_client->prior < partition->sp_thread.prior) {
+            tfm_core_thrd_change_priority(&partition->sp_thread,
+                                          p_client->prior);
+        }
+    }
+#endif
+
     /* Messages put. Update signals */
     partition->signals_asserted |= signal;
 
@@ -582,6 +664,11 @@ void tfm_spm_send_event(struct tfm_spm_service_t *service,
                     &partition->event,
                     (partition->signals_asserted & partition->signals_waiting));
         partition->signals_waiting &= ~signal;
+
+        /* The caller blocks below, hand the CPU over to the service */
+        if (!is_tfm_rpc_msg(msg)) {
+            tfm_core_thrd_set_handoff(&partition->sp_thread);
+        }
     }
 
     /*
@@ -605,6 +692,103 @@ int32_t tfm_spm_partition_get_running_partition_id(void)
     }
 }
 
+#if TFM_SPM_MEM_CHECK_CACHE_SIZE > 0
+/*
+ * Ranges which passed tfm_hal_memory_has_access() recently. An entry with
+ * zero length is empty. An entry only serves the partition which inserted it,
+ * or only non-secure callers. The checks run in SVC and PendSV handlers only,
+ * which do not preempt each other, so the cache needs no further protection.
+ */
+struct mem_check_cache_entry_t {
+    uintptr_t base;
+    size_t len;
+    uint32_t attr;
+    int32_t owner;
+};
+
+/* Owner of the entries of non-secure callers */
+#define MEM_CHECK_CACHE_NS_OWNER    INVALID_PARTITION_ID
+
+static struct mem_check_cache_entry_t
+                            mem_check_cache[TFM_SPM_MEM_CHECK_CACHE_SIZE];
+static uint32_t mem_check_cache_next;
+
+/*
+ * A cached range grants access to any sub-range with the same security state
+ * and privilege, for the same or fewer access permissions.
+ */
+#define MEM_CHECK_CACHE_EXACT_ATTR  (TFM_HAL_ACCESS_NS |                 \
+                                     TFM_HAL_ACCESS_UNPRIVILEGED)
+
+static int32_t mem_check_cache_owner(uint32_t attr)
+{
+    if (attr & TFM_HAL_ACCESS_NS) {
+        return MEM_CHECK_CACHE_NS_OWNER;
+    }
+
+    return tfm_spm_partition_get_running_partition_id();
+}
+
+static bool mem_check_cache_lookup(uintptr_t base, size_t len, uint32_t attr)
+{
+    uint32_t i;
+    const struct mem_check_cache_entry_t *entry;
+    int32_t owner = mem_check_cache_owner(attr);
+
+    for (i = 0; i < TFM_SPM_MEM_CHECK_CACHE_SIZE; i++) {
+        entry = &mem_check_cache[i];
+        if ((entry->len == 0) || (entry->owner != owner)) {
+            continue;
+        }
+
+        if (((entry->attr ^ attr) & MEM_CHECK_CACHE_EXACT_ATTR) ||
+            (attr & ~entry->attr)) {
+            continue;
+        }
+
+        /* Overflow of both ranges has been checked before caching. */
+        if ((base >= entry->base) &&
+            (base + len <= entry->base + entry->len)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void mem_check_cache_insert(uintptr_t base, size_t len, uint32_t attr)
+{
+    struct mem_check_cache_entry_t *entry;
+
+#ifndef TFM_MULTI_CORE_TOPOLOGY
+    /*
+     * Non-secure access rights follow the non-secure MPU settings, which the
+     * NSPE can change at any time. Only cache secure ranges.
+     */
+    if (attr & TFM_HAL_ACCESS_NS) {
+        return;
+    }
+#endif
+
+    entry = &mem_check_cache[mem_check_cache_next];
+    entry->base = base;
+    entry->len = len;
+    entry->attr = attr;
+    entry->owner = mem_check_cache_owner(attr);
+
+    mem_check_cache_next = (mem_check_cache_next + 1) %
+                           TFM_SPM_MEM_CHECK_CACHE_SIZE;
+}
+#endif /* TFM_SPM_MEM_CHECK_CACHE_SIZE > 0 */
+
+void tfm_spm_mem_check_cache_invalidate(void)
+{
+#if TFM_SPM_MEM_CHECK_CACHE_SIZE > 0
+    spm_memset(mem_check_cache, 0, sizeof(mem_check_cache));
+    mem_check_cache_next = 0;
+#endif
+}
+
 int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
                          enum tfm_memory_access_e access,
                          uint32_t privileged)
@@ -639,17 +823,95 @@ int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
 
     if (ns_caller) {
         attr |= TFM_HAL_ACCESS_NS;
+
+#ifdef TFM_MULTI_CORE_TOPOLOGY
+        /* The NSPE shared buffer arena has been checked for any NS access */
+        if (tfm_mailbox_is_arena_buf(buffer, len)) {
+            return SPM_SUCCESS;
+        }
+#endif
     }
 
+#if TFM_SPM_MEM_CHECK_CACHE_SIZE > 0
+    if (mem_check_cache_lookup((uintptr_t)buffer, len, attr)) {
+        return SPM_SUCCESS;
+    }
+#endif
+
     err = tfm_hal_memory_has_access((uintptr_t)buffer, len, attr);
 
     if (err == TFM_HAL_SUCCESS) {
+#if TFM_SPM_MEM_CHECK_CACHE_SIZE > 0
+        mem_check_cache_insert((uintptr_t)buffer, len, attr);
+#endif
         return SPM_SUCCESS;
     }
 
     return SPM_ERROR_MEMORY_CHECK;
 }
 
+#ifdef TFM_SPM_DEBUG_STATS
+/* Pattern painted on partition stacks to find their high-water marks */
+#define SPM_STACK_PAINT_PATTERN         0xCDCDCDCD
+
+static void spm_paint_stack(const struct tfm_spm_partition_memory_data_t *mem)
+{
+    uint32_t *p_word = (uint32_t *)mem->stack_bottom;
+
+    while ((uintptr_t)p_word < mem->stack_top) {
+        *p_word++ = SPM_STACK_PAINT_PATTERN;
+    }
+}
+
+/* Bytes of the stack written since painting, as stacks grow downwards */
+static uint32_t
+spm_stack_used(const struct tfm_spm_partition_memory_data_t *mem)
+{
+    const uint32_t *p_word = (const uint32_t *)mem->stack_bottom;
+
+    while ((uintptr_t)p_word < mem->stack_top &&
+           *p_word == SPM_STACK_PAINT_PATTERN) {
+        p_word++;
+    }
+
+    return (uint32_t)(mem->stack_top - (uintptr_t)p_word);
+}
+
+static void spm_get_partition_stats(const struct partition_t *partition,
+                                    struct tfm_spm_partition_stats_t *stats)
+{
+    const struct tfm_spm_partition_memory_data_t *mem = partition->memory_data;
+
+    stats->stack_size = mem->stack_top - mem->stack_bottom;
+    stats->stack_used = 0;
+    if (partition->p_static->pid != TFM_SP_NON_SECURE_ID) {
+        stats->stack_used = spm_stack_used(mem);
+    }
+    stats->run_count = partition->sp_thread.run_count;
+    stats->run_time = partition->sp_thread.run_time;
+}
+
+static void spm_log_partition_stats(void)
+{
+    uint32_t i;
+    struct tfm_spm_partition_stats_t stats;
+    const struct partition_t *partition;
+
+    for (i = 0; i < g_spm_partition_db.partition_count; i++) {
+        partition = &g_spm_partition_db.partitions[i];
+        spm_get_partition_stats(partition, &stats);
+
+        SPMLOG_INFMSGVAL("[SPM] Partition: ", partition->p_static->pid);
+        SPMLOG_INFMSGVAL("  stack size: ", stats.stack_size);
+        SPMLOG_INFMSGVAL("  stack used: ", stats.stack_used);
+        SPMLOG_INFMSGVAL("  run count: ", stats.run_count);
+        SPMLOG_INFMSGVAL("  run time (high): ",
+                         (uint32_t)(stats.run_time >> 32));
+        SPMLOG_INFMSGVAL("  run time (low): ", (uint32_t)stats.run_time);
+    }
+}
+#endif /* TFM_SPM_DEBUG_STATS */
+
 uint32_t tfm_spm_init(void)
 {
     uint32_t i, j, num;
@@ -726,9 +988,19 @@ uint32_t tfm_spm_init(void)
 
         tfm_event_init(&partition->event);
         BI_LIST_INIT_NODE(&partition->msg_list);
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+        BI_LIST_INIT_NODE(&partition->serving_list);
+#endif
 
         pth = &partition->sp_thread;
 
+#ifdef TFM_SPM_DEBUG_STATS
+        /* The non-secure entry stack is in use by this initialization */
+        if (partition->p_static->pid != TFM_SP_NON_SECURE_ID) {
+            spm_paint_stack(partition->memory_data);
+        }
+#endif
+
         tfm_core_thrd_init(pth,
                            (tfm_core_thrd_entry_t)partition->p_static->entry,
                            NULL,
@@ -798,6 +1070,16 @@ uint32_t tfm_spm_init(void)
     return p_ns_entry_thread->arch_ctx.lr;
 }
 
+#if TFM_LVL == 3
+/* The partition whose private data boundary is programmed into the MPU */
+static const struct partition_t *p_boundary_partition;
+#endif
+
+#ifdef TFM_SPM_DEBUG_STATS
+/* Counted by the scheduler, only PendSV updates them */
+static struct tfm_spm_mpu_stats_t mpu_stats;
+#endif
+
 void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
 {
 #if TFM_LVL != 1
@@ -830,26 +1112,48 @@ void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
          * PRoTs cannot work in unprivileged mode, make them privileged now.
          */
         if (is_privileged == TFM_PARTITION_UNPRIVILEGED_MODE) {
-            /* FIXME: only MPU-based implementations are supported currently */
+            /*
+             * Privileged partitions leave the boundary untouched, so it may
+             * still protect the incoming partition. Skip reprogramming then.
+             */
+            if (p_next_partition == p_boundary_partition) {
+#ifdef TFM_SPM_DEBUG_STATS
+                mpu_stats.skipped++;
+#endif
+            } else {
+                /* FIXME: only MPU-based implementations supported currently */
 #ifdef TFM_FIH_PROFILE_ON
-            FIH_CALL(tfm_hal_mpu_update_partition_boundary, fih_rc,
-                     p_next_partition->memory_data->data_start,
-                     p_next_partition->memory_data->data_limit);
-            if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
-                tfm_core_panic();
-            }
+                FIH_CALL(tfm_hal_mpu_update_partition_boundary, fih_rc,
+                         p_next_partition->memory_data->data_start,
+                         p_next_partition->memory_data->data_limit);
+                if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
+                    tfm_core_panic();
+                }
 #else /* TFM_FIH_PROFILE_ON */
-            if (tfm_hal_mpu_update_partition_boundary(
+                if (tfm_hal_mpu_update_partition_boundary(
                                       p_next_partition->memory_data->data_start,
                                       p_next_partition->memory_data->data_limit)
                                                            != TFM_HAL_SUCCESS) {
-                tfm_core_panic();
-            }
+                    tfm_core_panic();
+                }
 #endif /* TFM_FIH_PROFILE_ON */
+                p_boundary_partition = p_next_partition;
+#ifdef TFM_SPM_DEBUG_STATS
+                mpu_stats.updates++;
+#endif
+                /* Cached results were checked against the previous boundary */
+                tfm_spm_mem_check_cache_invalidate();
+            }
         }
 #endif /* TFM_LVL == 3 */
 #endif /* TFM_LVL != 1 */
 
+        SPM_TRACE(TFM_SPM_TRACE_EVT_SWITCH,
+                  (TFM_GET_CONTAINER_PTR(pth_curr, struct partition_t,
+                                         sp_thread))->p_static->pid,
+                  (TFM_GET_CONTAINER_PTR(pth_next, struct partition_t,
+                                         sp_thread))->p_static->pid);
+
         tfm_core_thrd_switch_context(p_actx, pth_curr, pth_next);
     }
 
@@ -934,25 +1238,82 @@ void tfm_set_irq_signal(uint32_t partition_id, psa_signal_t signal,
     tfm_spm_hal_disable_irq((IRQn_Type)irq_line);
     notify_with_signal(partition_id, signal);
 
+    SPM_TRACE(TFM_SPM_TRACE_EVT_IRQ_SIGNAL, partition_id, irq_line);
+
     __enable_irq();
 }
 
-int32_t get_irq_line_for_signal(int32_t partition_id, psa_signal_t signal)
+/**
+ * \brief Sets signal to partition for a coalesced IRQ
+ *
+ * \param[in] partition_id      The ID of the partition which handles this IRQ
+ * \param[in] signal            The signal associated with this IRQ
+ * \param[in] irq_line          The number of the IRQ line
+ * \param[in] p_pending         Count of assertions not acknowledged yet
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    Partition ID is invalid
+ *
+ * \note The IRQ line is left enabled. Assertions are counted and only the
+ *       first one after an acknowledgement notifies the partition.
+ */
+void tfm_set_coalesced_irq_signal(uint32_t partition_id, psa_signal_t signal,
+                                  uint32_t irq_line,
+                                  volatile uint32_t *p_pending)
+{
+    __disable_irq();
+
+    if ((*p_pending)++ == 0) {
+        notify_with_signal(partition_id, signal);
+    }
+
+    SPM_TRACE(TFM_SPM_TRACE_EVT_IRQ_SIGNAL, partition_id, irq_line);
+
+    __enable_irq();
+}
+
+void tfm_spm_notify_doorbell_isr(int32_t partition_id)
+{
+    __disable_irq();
+
+    notify_with_signal(partition_id, PSA_DOORBELL);
+
+    __enable_irq();
+}
+
+const struct tfm_core_irq_signal_data_t *
+get_irq_data_for_signal(int32_t partition_id, psa_signal_t signal)
 {
     size_t i;
 
     if (!IS_ONLY_ONE_BIT_IN_UINT32(signal)) {
-        return -1;
+        return NULL;
     }
 
     for (i = 0; i < tfm_core_irq_signals_count; ++i) {
         if (tfm_core_irq_signals[i].partition_id == partition_id &&
             tfm_core_irq_signals[i].signal_value == signal) {
-            return tfm_core_irq_signals[i].irq_line;
+            return &tfm_core_irq_signals[i];
         }
     }
 
-    return SPM_ERROR_GENERIC;
+    return NULL;
+}
+
+int32_t get_irq_line_for_signal(int32_t partition_id, psa_signal_t signal)
+{
+    const struct tfm_core_irq_signal_data_t *irq_data;
+
+    if (!IS_ONLY_ONE_BIT_IN_UINT32(signal)) {
+        return -1;
+    }
+
+    irq_data = get_irq_data_for_signal(partition_id, signal);
+    if (!irq_data) {
+        return SPM_ERROR_GENERIC;
+    }
+
+    return irq_data->irq_line;
 }
 
 #if !defined(__ARM_ARCH_8_1M_MAIN__)
@@ -1031,3 +1392,88 @@ void tfm_spm_request_handler(const struct tfm_state_context_t *svc_ctx)
         *res_ptr = (uint32_t)TFM_ERROR_INVALID_PARAMETER;
     }
 }
+
+#ifdef TFM_SPM_DEBUG_STATS
+int32_t tfm_spm_get_stats_handler(uint32_t *args)
+{
+    uint32_t type = args[0];
+    void *buf = (void *)args[1];
+    size_t len = (size_t)args[2];
+    struct partition_t *partition;
+    struct tfm_pool_stats_t pool_stats;
+    struct tfm_spm_pool_stats_t *p_pool_stats;
+    struct tfm_spm_mpu_stats_t *p_mpu_stats;
+    struct tfm_spm_partition_stats_t *p_part_stats;
+    struct partition_t *p_target;
+    uint32_t privileged;
+
+    partition = tfm_spm_get_running_partition();
+    if (!partition) {
+        tfm_core_panic();
+    }
+
+    /* Statistics expose SPM internals, restrict them to PSA RoT */
+    if ((partition->p_static->flags & SPM_PART_FLAG_PSA_ROT) == 0) {
+        return (int32_t)TFM_ERROR_GENERIC;
+    }
+
+    if (type == TFM_SPM_STATS_LOG) {
+        spm_log_partition_stats();
+        return (int32_t)TFM_SUCCESS;
+    }
+
+    privileged =
+        tfm_spm_partition_get_privileged_mode(partition->p_static->flags);
+    if (tfm_memory_check(buf, len, false, TFM_MEMORY_ACCESS_RW,
+                         privileged) != SPM_SUCCESS) {
+        return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    switch (type) {
+    case TFM_SPM_STATS_CONN_HANDLE_POOL:
+        if (len < sizeof(struct tfm_spm_pool_stats_t)) {
+            return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+        }
+        tfm_pool_get_stats(conn_handle_pool, &pool_stats);
+        p_pool_stats = (struct tfm_spm_pool_stats_t *)buf;
+        p_pool_stats->chunk_count = pool_stats.chunk_count;
+        p_pool_stats->in_use = pool_stats.in_use;
+        p_pool_stats->high_water = pool_stats.high_water;
+        p_pool_stats->exhausted = pool_stats.exhausted;
+        break;
+    case TFM_SPM_STATS_MPU_UPDATE:
+        if (len < sizeof(struct tfm_spm_mpu_stats_t)) {
+            return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+        }
+        p_mpu_stats = (struct tfm_spm_mpu_stats_t *)buf;
+        p_mpu_stats->updates = mpu_stats.updates;
+        p_mpu_stats->skipped = mpu_stats.skipped;
+        p_mpu_stats->timestamp = tfm_hal_get_timestamp();
+        break;
+    case TFM_SPM_STATS_PARTITION:
+        if (len < sizeof(struct tfm_spm_partition_stats_t)) {
+            return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+        }
+        p_part_stats = (struct tfm_spm_partition_stats_t *)buf;
+        p_target = tfm_spm_get_partition_by_id(p_part_stats->partition_id);
+        if (!p_target) {
+            return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+        }
+        spm_get_partition_stats(p_target, p_part_stats);
+        break;
+#if defined(TFM_MULTI_CORE_TOPOLOGY) && defined(TFM_MULTI_CORE_MAILBOX_STATS)
+    case TFM_SPM_STATS_MAILBOX:
+        if ((len < sizeof(struct mailbox_stats_t)) ||
+            (tfm_mailbox_get_stats((struct mailbox_stats_t *)buf) !=
+             MAILBOX_SUCCESS)) {
+            return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+        }
+        break;
+#endif
+    default:
+        return (int32_t)TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    return (int32_t)TFM_SUCCESS;
+}
+#endif /* TFM_SPM_DEBUG_STATS */
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include "spm_partition_defs.h"
 #include "tfm_arch.h"
+#include "tfm_irq_list.h"
 #include "lists.h"
 #include "tfm_wait.h"
 #include "tfm_secure_api.h"
@@ -27,10 +28,18 @@
 #define TFM_HANDLE_STATUS_CONNECT_ERROR 2
 
 #define PART_REGION_ADDR(partition, region) \
-    (uint32_t)&REGION_NAME(Image$$, partition, region)
+    (uintptr_t)&REGION_NAME(Image$$, partition, region)
 
 #define TFM_CONN_HANDLE_MAX_NUM         16
 
+/*
+ * Number of ranges cached by tfm_memory_check(), 0 disables the cache. A cached
+ * range is only reused for the same partition, or for non-secure callers.
+ */
+#ifndef TFM_SPM_MEM_CHECK_CACHE_SIZE
+#define TFM_SPM_MEM_CHECK_CACHE_SIZE    0
+#endif
+
 /*
  * Set a number limit for stateless handle.
  * Valid handle must be positive, set client handle minimum value to 1.
@@ -77,6 +86,41 @@
 
 #define TFM_MSG_MAGIC                   0x15154343
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+/*
+ * MM-IOVEC status of a message. Each vector owns IOVEC_STATUS_BITS bits of
+ * 'iovec_status', input vectors first and then output vectors:
+ *
+ * | 31 - 28   | ... | 15 - 12   | 11 - 8   | 7 - 4    | 3 - 0    |
+ * | outvec[3] | ... | invec[3]  | invec[2] | invec[1] | invec[0] |
+ */
+#define IOVEC_STATUS_BITS               4
+#define INVEC_IDX_BASE                  0
+#define OUTVEC_IDX_BASE                 PSA_MAX_IOVEC
+
+#define IOVEC_MAPPED_BIT                (1U << 0)
+#define IOVEC_UNMAPPED_BIT              (1U << 1)
+#define IOVEC_ACCESSED_BIT              (1U << 2)
+
+#define IOVEC_STATUS_IS_SET(msg, iovec_idx, bit)                       \
+    ((((msg)->iovec_status) >> ((iovec_idx) * IOVEC_STATUS_BITS)) & (bit))
+#define IOVEC_STATUS_SET(msg, iovec_idx, bit)                          \
+    ((msg)->iovec_status |= ((bit) << ((iovec_idx) * IOVEC_STATUS_BITS)))
+
+#define IOVEC_IS_MAPPED(msg, iovec_idx)                                \
+    IOVEC_STATUS_IS_SET(msg, iovec_idx, IOVEC_MAPPED_BIT)
+#define IOVEC_IS_UNMAPPED(msg, iovec_idx)                              \
+    IOVEC_STATUS_IS_SET(msg, iovec_idx, IOVEC_UNMAPPED_BIT)
+#define IOVEC_IS_ACCESSED(msg, iovec_idx)                              \
+    IOVEC_STATUS_IS_SET(msg, iovec_idx, IOVEC_ACCESSED_BIT)
+#define SET_IOVEC_MAPPED(msg, iovec_idx)                               \
+    IOVEC_STATUS_SET(msg, iovec_idx, IOVEC_MAPPED_BIT)
+#define SET_IOVEC_UNMAPPED(msg, iovec_idx)                             \
+    IOVEC_STATUS_SET(msg, iovec_idx, IOVEC_UNMAPPED_BIT)
+#define SET_IOVEC_ACCESSED(msg, iovec_idx)                             \
+    IOVEC_STATUS_SET(msg, iovec_idx, IOVEC_ACCESSED_BIT)
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+
 /* Message struct to collect parameter from client */
 struct tfm_msg_body_t {
     int32_t magic;
@@ -89,6 +133,9 @@ struct tfm_msg_body_t {
                                         * Save caller outvec pointer for
                                         * write length update
                                         */
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    uint32_t iovec_status;             /* MM-IOVEC status of the vectors */
+#endif
 #ifdef TFM_MULTI_CORE_TOPOLOGY
     const void *caller_data;           /*
                                         * Pointer to the private data of the
@@ -131,6 +178,9 @@ struct partition_t {
     struct tfm_core_thread_t sp_thread;
     struct tfm_event_t event;
     struct bi_list_node_t msg_list;
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+    struct bi_list_node_t serving_list; /* Messages got but not replied yet */
+#endif
     uint32_t signals_allowed;
     uint32_t signals_waiting;
     uint32_t signals_asserted;
@@ -151,6 +201,7 @@ struct tfm_spm_service_db_t {
     uint32_t sid;                   /* Service identifier                    */
     bool non_secure_client;         /* If can be called by non secure client */
     bool connection_based;          /* 'true' for connection-based service   */
+    bool mm_iovec;                  /* 'true' if MM-IOVEC is enabled         */
     uint32_t version;               /* Service version                       */
     uint32_t version_policy;        /* Service version policy                */
 };
@@ -391,6 +442,16 @@ int32_t tfm_spm_check_authorization(uint32_t sid,
                                     struct tfm_spm_service_t *service,
                                     bool ns_caller);
 
+/**
+ * \brief                      Drop all the cached results of
+ *                             \ref tfm_memory_check.
+ *
+ * \note                       It must be called whenever the isolation
+ *                             boundaries or memory access attributes checked
+ *                             by tfm_hal_memory_has_access() change.
+ */
+void tfm_spm_mem_check_cache_invalidate(void);
+
 /**
  * \brief                      Check the memory reference is valid.
  *
@@ -406,6 +467,9 @@ int32_t tfm_spm_check_authorization(uint32_t sid,
  * \retval SPM_SUCCESS               Success
  * \retval SPM_ERROR_BAD_PARAMETERS  Bad parameters input
  * \retval SPM_ERROR_MEMORY_CHECK    Check failed
+ *
+ * \note                       Successful results are cached, see
+ *                             \ref tfm_spm_mem_check_cache_invalidate.
  */
 int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
                          enum tfm_memory_access_e access,
@@ -501,6 +565,18 @@ int32_t tfm_spm_set_rhandle(struct tfm_spm_service_t *service,
 
 void update_caller_outvec_len(struct tfm_msg_body_t *msg);
 
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+/**
+ * \brief   Stop counting the client of a message replied to in the priority
+ *          of the partition serving it, and recompute that priority.
+ *
+ * \param[in] partition         The partition serving the clients.
+ * \param[in] msg               The message replied to.
+ */
+void tfm_spm_drop_inherited_priority(struct partition_t *partition,
+                                     struct tfm_msg_body_t *msg);
+#endif
+
 /**
  * \brief   notify the partition with the signal.
  *
@@ -513,6 +589,20 @@ void update_caller_outvec_len(struct tfm_msg_body_t *msg);
  */
 void notify_with_signal(int32_t partition_id, psa_signal_t signal);
 
+/**
+ * \brief   Ring the doorbell of a partition from an interrupt handler.
+ *
+ * \param[in] partition_id      The ID of the partition to be notified.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    If partition_id is invalid.
+ *
+ * \note This lets a platform IRQ handler wake up a partition without a
+ *       dedicated IRQ signal, such as the PSA Proxy partition on the replies
+ *       of the Secure Enclave.
+ */
+void tfm_spm_notify_doorbell_isr(int32_t partition_id);
+
 /**
  * \brief Return the IRQ line number associated with a signal
  *
@@ -528,4 +618,32 @@ void notify_with_signal(int32_t partition_id, psa_signal_t signal);
  */
 int32_t get_irq_line_for_signal(int32_t partition_id, psa_signal_t signal);
 
+/**
+ * \brief Return the IRQ data associated with a signal
+ *
+ * \param[in]      partition_id    The ID of the partition in which we look for
+ *                                 the signal.
+ * \param[in]      signal          The signal to query for.
+ *
+ * \retval NULL                 The \ref signal indicates more than one signal,
+ *                              or does not belong to the partition.
+ * \retval others               The IRQ data associated with the signal.
+ */
+const struct tfm_core_irq_signal_data_t *
+get_irq_data_for_signal(int32_t partition_id, psa_signal_t signal);
+
+#ifdef TFM_SPM_DEBUG_STATS
+/**
+ * \brief SVC handler for \ref tfm_spm_get_stats.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              type, buf, len.
+ *
+ * \retval TFM_SUCCESS          Statistics are copied into the buffer.
+ * \retval TFM_ERROR_INVALID_PARAMETER Unknown type or invalid buffer.
+ * \retval TFM_ERROR_GENERIC    Caller is not a PSA RoT partition.
+ */
+int32_t tfm_spm_get_stats_handler(uint32_t *args);
+#endif
+
 #endif /* __SPM_IPC_H__ */
@@ -18,7 +18,7 @@
 #include "tfm/tfm_core_svc.h"
 #include "ffm/tfm_boot_data.h"
 #include "ffm/psa_client_service_apis.h"
-#include "tfm_hal_spm_logdev.h"
+#include "tfm_spm_log.h"
 
 /* The section names come from the scatter file */
 REGION_DECLARE(Image$$, TFM_UNPRIV_CODE, $$RO$$Base);
@@ -104,15 +104,33 @@ static int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx,
         break;
     case TFM_SVC_PSA_LIFECYCLE:
         return tfm_spm_get_lifecycle_state();
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    case TFM_SVC_PSA_MAP_INVEC:
+        return (uint32_t)tfm_spm_psa_map_invec(ctx);
+    case TFM_SVC_PSA_UNMAP_INVEC:
+        tfm_spm_psa_unmap_invec(ctx);
+        break;
+    case TFM_SVC_PSA_MAP_OUTVEC:
+        return (uint32_t)tfm_spm_psa_map_outvec(ctx);
+    case TFM_SVC_PSA_UNMAP_OUTVEC:
+        tfm_spm_psa_unmap_outvec(ctx);
+        break;
+#endif
 #if (TFM_SPM_LOG_LEVEL > TFM_SPM_LOG_LEVEL_SILENCE)
     case TFM_SVC_OUTPUT_UNPRIV_STRING:
-        return tfm_hal_output_spm_log((const char *)ctx[0], ctx[1]);
+        return spm_log_str((const char *)ctx[0], ctx[1]);
 #endif
     case TFM_SVC_PSA_IRQ_ENABLE:
         tfm_spm_irq_enable(ctx);
         break;
     case TFM_SVC_PSA_IRQ_DISABLE:
         return tfm_spm_irq_disable(ctx);
+    case TFM_SVC_IRQ_TAKE_PENDING:
+        return tfm_spm_irq_take_pending(ctx);
+#ifdef TFM_SPM_DEBUG_STATS
+    case TFM_SVC_SPM_GET_STATS:
+        return tfm_spm_get_stats_handler(ctx);
+#endif
     default:
 #ifdef PLATFORM_SVC_HANDLERS
         return (platform_svc_handlers(svc_num, ctx, lr));
@@ -38,6 +38,8 @@ void tfm_nspm_thread_entry(void)
      * It requires privileged access to platform specific hardware.
      */
     while (1) {
+        /* Output the buffered log while the secure core has nothing to do */
+        spm_log_drain();
         __WFI();
     }
 
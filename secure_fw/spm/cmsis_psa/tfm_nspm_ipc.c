@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,15 +10,70 @@
 #include <stdbool.h>
 #include "tfm_spm_hal.h"
 #include "psa/error.h"
+#include "tfm_api.h"
+#include "tfm_arch.h"
 #include "tfm_nspm.h"
 #include "utilities.h"
 #include "ext/tz_context.h"
 
 #define DEFAULT_NS_CLIENT_ID ((int32_t)-1)
 
+#define EXC_NUM_THREAD_MODE  (0)
+
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+#ifndef TFM_MAX_NS_THREAD_COUNT
+#define TFM_MAX_NS_THREAD_COUNT 8
+#endif
+#define INVALID_CLIENT_ID 0
+
+/* Client IDs of the NS contexts, indexed by TZ_MemoryId_t - 1 */
+static int32_t ns_client_id_list[TFM_MAX_NS_THREAD_COUNT];
+
+/*
+ * The context loaded by the NS RTOS. The client ID is only looked up when a
+ * secure call arrives, so the context switch veneers just record the ID.
+ */
+static volatile TZ_MemoryId_t active_ns_ctx_id;
+
+static int32_t get_next_ns_client_id(void)
+{
+    static int32_t next_ns_client_id = DEFAULT_NS_CLIENT_ID - 1;
+
+    if (next_ns_client_id > DEFAULT_NS_CLIENT_ID - 1) {
+        next_ns_client_id = DEFAULT_NS_CLIENT_ID - 1;
+    }
+    return next_ns_client_id--;
+}
+
+/* Return the list slot of a context ID, or NULL if the context is not used */
+static int32_t *get_ns_client_slot(TZ_MemoryId_t id)
+{
+    if ((id == 0U) || (id > TFM_MAX_NS_THREAD_COUNT)) {
+        return NULL;
+    }
+
+    if (ns_client_id_list[id - 1] == INVALID_CLIENT_ID) {
+        return NULL;
+    }
+
+    return &ns_client_id_list[id - 1];
+}
+#endif /* CONFIG_TFM_ENABLE_CTX_MGMT && TFM_NS_CLIENT_IDENTIFICATION */
+
 int32_t tfm_nspm_get_current_client_id(void)
 {
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    int32_t *p_client_id = get_ns_client_slot(active_ns_ctx_id);
+
+    /* Threads without a secure context are the default client */
+    if (!p_client_id) {
+        return DEFAULT_NS_CLIENT_ID;
+    }
+
+    return *p_client_id;
+#else
     return DEFAULT_NS_CLIENT_ID;
+#endif
 }
 
 /* TF-M implementation of the CMSIS TZ RTOS thread context management API */
@@ -27,6 +84,20 @@ int32_t tfm_nspm_get_current_client_id(void)
 __tfm_nspm_secure_gateway_attributes__
 uint32_t TZ_InitContextSystem_S(void)
 {
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    uint32_t i;
+
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return 0U;
+    }
+
+    for (i = 0; i < TFM_MAX_NS_THREAD_COUNT; i++) {
+        ns_client_id_list[i] = INVALID_CLIENT_ID;
+    }
+    active_ns_ctx_id = 0U;
+#endif
+
     return 1U;
 }
 
@@ -38,9 +109,32 @@ uint32_t TZ_InitContextSystem_S(void)
 __tfm_nspm_secure_gateway_attributes__
 TZ_MemoryId_t TZ_AllocModuleContext_S (TZ_ModuleId_t module)
 {
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    uint32_t i;
+#endif
+
     /* add attribute 'noinline' to avoid a build error. */
     (void)module;
+
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return 0U;
+    }
+
+    for (i = 0; i < TFM_MAX_NS_THREAD_COUNT; i++) {
+        if (ns_client_id_list[i] == INVALID_CLIENT_ID) {
+            ns_client_id_list[i] = get_next_ns_client_id();
+            /* TZ_MemoryId_t must be a positive integer */
+            return (TZ_MemoryId_t)(i + 1);
+        }
+    }
+
+    /* No more free slots */
+    return 0U;
+#else
     return 1U;
+#endif
 }
 
 /// Free context memory that was previously allocated with \ref TZ_AllocModuleContext_S
@@ -50,7 +144,28 @@ TZ_MemoryId_t TZ_AllocModuleContext_S (TZ_ModuleId_t module)
 __tfm_nspm_secure_gateway_attributes__
 uint32_t TZ_FreeModuleContext_S (TZ_MemoryId_t id)
 {
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    int32_t *p_client_id;
+
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return 0U;
+    }
+
+    p_client_id = get_ns_client_slot(id);
+    if (!p_client_id) {
+        /* Non-existent client */
+        return 0U;
+    }
+
+    *p_client_id = INVALID_CLIENT_ID;
+    if (active_ns_ctx_id == id) {
+        active_ns_ctx_id = 0U;
+    }
+#else
     (void)id;
+#endif
+
     return 1U;
 }
 
@@ -61,7 +176,18 @@ uint32_t TZ_FreeModuleContext_S (TZ_MemoryId_t id)
 __tfm_nspm_secure_gateway_attributes__
 uint32_t TZ_LoadContext_S (TZ_MemoryId_t id)
 {
+#if defined(CONFIG_TFM_ENABLE_CTX_MGMT) && defined(TFM_NS_CLIENT_IDENTIFICATION)
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return 0U;
+    }
+
+    /* Validated when a secure call looks the client ID up */
+    active_ns_ctx_id = id;
+#else
     (void)id;
+#endif
+
     return 1U;
 }
 
@@ -72,10 +198,46 @@ uint32_t TZ_LoadContext_S (TZ_MemoryId_t id)
 __tfm_nspm_secure_gateway_attributes__
 uint32_t TZ_StoreContext_S (TZ_MemoryId_t id)
 {
+    /* Nothing to store, the next TZ_LoadContext_S() replaces the context */
     (void)id;
     return 1U;
 }
 
+#ifdef TFM_NS_CLIENT_IDENTIFICATION
+__tfm_nspm_secure_gateway_attributes__
+enum tfm_status_e tfm_register_client_id (int32_t ns_client_id)
+{
+#ifdef CONFIG_TFM_ENABLE_CTX_MGMT
+    int32_t *p_client_id;
+#endif
+
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return TFM_ERROR_NS_THREAD_MODE_CALL;
+    }
+
+    if (ns_client_id >= 0) {
+        /* The client ID is invalid */
+        return TFM_ERROR_INVALID_PARAMETER;
+    }
+
+#ifdef CONFIG_TFM_ENABLE_CTX_MGMT
+    p_client_id = get_ns_client_slot(active_ns_ctx_id);
+    if (!p_client_id) {
+        /* No client is active */
+        return TFM_ERROR_GENERIC;
+    }
+
+    *p_client_id = ns_client_id;
+
+    return TFM_SUCCESS;
+#else
+    /* No NS contexts to assign the client ID to */
+    return TFM_ERROR_GENERIC;
+#endif
+}
+#endif
+
 /*
  * 'r0' impliedly holds the address of non-secure entry,
  * given during non-secure partition initialization.
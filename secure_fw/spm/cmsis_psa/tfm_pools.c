@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -7,104 +9,184 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include "tfm_thread.h"
-#include "tfm_wait.h"
-#include "psa/client.h"
-#include "psa/service.h"
+#include "bitops.h"
 #include "internal_errors.h"
-#include "cmsis_compiler.h"
+#include "tfm_arch.h"
 #include "utilities.h"
-#include "lists.h"
 #include "tfm_pools.h"
-#include "tfm_memory_utils.h"
 #include "tfm_core_utils.h"
 
+/* Atomically raise '*addr' to 'val' if it is lower. */
+static void pool_word_max(volatile uint32_t *addr, uint32_t val)
+{
+    uint32_t old_val;
+
+    do {
+        old_val = *addr;
+        if (old_val >= val) {
+            return;
+        }
+    } while (!tfm_arch_cas_u32(addr, old_val, val));
+}
+
+/* Index of the lowest set bit. 'word' must not be zero. */
+__STATIC_INLINE uint32_t pool_first_set_bit(uint32_t word)
+{
+    return (TFM_POOL_BITMAP_WORD_BITS - 1) - __CLZ(word & (~word + 1));
+}
+
+/*
+ * Convert a chunk data pointer into chunk index. Returns 'chunk_count' if the
+ * pointer is not the start address of a chunk in the pool.
+ */
+static size_t pool_chunk_index(const struct tfm_pool_instance_t *pool,
+                               const uint8_t *data)
+{
+    uintptr_t offset;
+
+    if ((uintptr_t)data < (uintptr_t)pool->chunks) {
+        return pool->chunk_count;
+    }
+
+    offset = (uintptr_t)data - (uintptr_t)pool->chunks;
+
+    if (pool->stride_shift != 0) {
+        if (offset & (pool->chunk_stride - 1)) {
+            return pool->chunk_count;
+        }
+        offset >>= pool->stride_shift;
+    } else {
+        if (offset % pool->chunk_stride != 0) {
+            return pool->chunk_count;
+        }
+        offset /= pool->chunk_stride;
+    }
+
+    return offset < pool->chunk_count ? (size_t)offset : pool->chunk_count;
+}
+
 int32_t tfm_pool_init(struct tfm_pool_instance_t *pool, size_t poolsz,
                       size_t chunksz, size_t num)
 {
-    struct tfm_pool_chunk_t *pchunk;
-    size_t i;
+    size_t i, stride, words;
 
     if (!pool || num == 0) {
         return SPM_ERROR_BAD_PARAMETERS;
     }
 
+    stride = TFM_POOL_CHUNK_STRIDE(chunksz);
+    words = TFM_POOL_BITMAP_WORDS(num);
+
     /* Ensure buffer is large enough */
-    if (poolsz != ((chunksz + sizeof(struct tfm_pool_chunk_t)) * num +
-        sizeof(struct tfm_pool_instance_t))) {
+    if (poolsz != (sizeof(struct tfm_pool_instance_t) +
+                   words * sizeof(uint32_t) + stride * num)) {
         return SPM_ERROR_BAD_PARAMETERS;
     }
 
     /* Buffer should be BSS cleared but clear it again */
     spm_memset(pool, 0, poolsz);
 
-    /* Chain pool chunks */
-    BI_LIST_INIT_NODE(&pool->chunks_list);
-
-    pchunk = (struct tfm_pool_chunk_t *)pool->chunks;
-    for (i = 0; i < num; i++) {
-        BI_LIST_INSERT_BEFORE(&pool->chunks_list, &pchunk->list);
-        pchunk = (struct tfm_pool_chunk_t *)&pchunk->data[chunksz];
+    /* Mark every chunk as free, the bits beyond 'num' stay cleared */
+    for (i = 0; i < num / TFM_POOL_BITMAP_WORD_BITS; i++) {
+        pool->bitmap[i] = UINT32_MAX;
+    }
+    if (num % TFM_POOL_BITMAP_WORD_BITS) {
+        pool->bitmap[i] = (1UL << (num % TFM_POOL_BITMAP_WORD_BITS)) - 1;
     }
 
-    /* Prepare instance and insert to pool list */
+    /* Prepare instance */
     pool->chunksz = chunksz;
     pool->chunk_count = num;
+    pool->chunk_stride = stride;
+    pool->stride_shift = 0;
+    if (IS_ONLY_ONE_BIT_IN_UINT32(stride)) {
+        pool->stride_shift = pool_first_set_bit((uint32_t)stride);
+    }
+    pool->chunks = (uint8_t *)&pool->bitmap[words];
+    pool->stats.chunk_count = (uint32_t)num;
 
     return SPM_SUCCESS;
 }
 
 void *tfm_pool_alloc(struct tfm_pool_instance_t *pool)
 {
-    struct bi_list_node_t *node;
-    struct tfm_pool_chunk_t *pchunk;
+    size_t i, words;
+    uint32_t word, bit, in_use;
 
     if (!pool) {
         return NULL;
     }
 
-    if (BI_LIST_IS_EMPTY(&pool->chunks_list)) {
-        return NULL;
+    words = TFM_POOL_BITMAP_WORDS(pool->chunk_count);
+
+    for (i = 0; i < words; i++) {
+        /* Retry on this word until it is claimed or runs out of free bits */
+        while ((word = ((volatile uint32_t *)pool->bitmap)[i]) != 0) {
+            bit = pool_first_set_bit(word);
+            if (tfm_arch_cas_u32(&pool->bitmap[i], word,
+                                 word & ~(1UL << bit))) {
+                in_use = tfm_arch_fetch_add_u32(&pool->stats.in_use, 1) + 1;
+                pool_word_max(&pool->stats.high_water, in_use);
+
+                return &pool->chunks[(i * TFM_POOL_BITMAP_WORD_BITS + bit) *
+                                     pool->chunk_stride];
+            }
+        }
     }
 
-    node = BI_LIST_NEXT_NODE(&pool->chunks_list);
-    pchunk = TFM_GET_CONTAINER_PTR(node, struct tfm_pool_chunk_t, list);
-
-    /* Remove node from list node, it will be added when pool free */
-    BI_LIST_REMOVE_NODE(node);
+    tfm_arch_fetch_add_u32(&pool->stats.exhausted, 1);
 
-    return &pchunk->data;
+    return NULL;
 }
 
 void tfm_pool_free(struct tfm_pool_instance_t *pool, void *ptr)
 {
-    struct tfm_pool_chunk_t *pchunk;
+    size_t idx;
+    uint32_t word, mask;
+    volatile uint32_t *p_word;
+
+    idx = pool_chunk_index(pool, (const uint8_t *)ptr);
+    if (idx >= pool->chunk_count) {
+        tfm_core_panic();
+    }
 
-    pchunk = TFM_GET_CONTAINER_PTR(ptr, struct tfm_pool_chunk_t, data);
-    BI_LIST_INSERT_BEFORE(&pool->chunks_list, &pchunk->list);
+    p_word = &pool->bitmap[idx / TFM_POOL_BITMAP_WORD_BITS];
+    mask = 1UL << (idx % TFM_POOL_BITMAP_WORD_BITS);
+
+    do {
+        word = *p_word;
+        /* A set bit means the chunk is free already: double free */
+        if (word & mask) {
+            tfm_core_panic();
+        }
+    } while (!tfm_arch_cas_u32(p_word, word, word | mask));
+
+    tfm_arch_fetch_add_u32(&pool->stats.in_use, (uint32_t)-1);
 }
 
 bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
                                  uint8_t *data)
 {
-    const uintptr_t chunks_start = (uintptr_t)(pool->chunks);
-    const size_t chunks_size = pool->chunksz + sizeof(struct tfm_pool_chunk_t);
-    const size_t chunk_count = pool->chunk_count;
-    const uintptr_t chunks_end = chunks_start + chunks_size * chunk_count;
-    uintptr_t pool_chunk_address = 0;
+    size_t idx = pool_chunk_index(pool, data);
 
     /* Check that the message was allocated from the pool. */
-    if ((uintptr_t)data < chunks_start || (uintptr_t)data >= chunks_end) {
+    if (idx >= pool->chunk_count) {
         return false;
     }
 
-    pool_chunk_address =
-    (uint32_t)TFM_GET_CONTAINER_PTR(data, struct tfm_pool_chunk_t, data);
-
-    /* Make sure that the chunk containing the message is aligned on */
-    /* chunk boundary in the pool. */
-    if ((pool_chunk_address - chunks_start) % chunks_size != 0) {
+    /* Make sure that the chunk is not free. */
+    if (pool->bitmap[idx / TFM_POOL_BITMAP_WORD_BITS] &
+        (1UL << (idx % TFM_POOL_BITMAP_WORD_BITS))) {
         return false;
     }
+
     return true;
 }
+
+void tfm_pool_get_stats(const struct tfm_pool_instance_t *pool,
+                        struct tfm_pool_stats_t *stats)
+{
+    TFM_CORE_ASSERT(pool && stats);
+
+    spm_memcpy(stats, &pool->stats, sizeof(*stats));
+}
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,22 +10,46 @@
 #define __TFM_POOLS_H__
 
 #include <stdbool.h>
-#include "lists.h"
+#include <stddef.h>
+#include <stdint.h>
 
 /*
  * Pool Instance:
- *  [ Pool Instance ] + N * [ Pool Chunks ]
+ *  [ Pool Instance ] + [ Free bitmap ] + N * [ Pool Chunks ]
+ *
+ * Each chunk owns one bit in the free bitmap, a set bit means the chunk is
+ * free. Chunks are laid out with a fixed stride so that a pointer can be
+ * converted into a chunk index without walking any list.
  */
-struct tfm_pool_chunk_t {
-    struct bi_list_node_t list;         /* Chunk list                     */
-    uint8_t data[];                     /* Data indicator                 */
+#define TFM_POOL_BITMAP_WORD_BITS       32
+
+/* Number of bitmap words needed to track 'num' chunks */
+#define TFM_POOL_BITMAP_WORDS(num)                                          \
+    (((num) + TFM_POOL_BITMAP_WORD_BITS - 1) / TFM_POOL_BITMAP_WORD_BITS)
+
+/* Distance in bytes between two chunks, word aligned */
+#define TFM_POOL_CHUNK_STRIDE(chunksz)                                      \
+    (((chunksz) + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1))
+
+/* Usage statistics of a pool */
+struct tfm_pool_stats_t {
+    uint32_t chunk_count;               /* Number of chunks in the pool   */
+    uint32_t in_use;                    /* Chunks currently allocated     */
+    uint32_t high_water;                /* Maximum of in_use ever reached */
+    uint32_t exhausted;                 /* Allocations failed as empty    */
 };
 
 struct tfm_pool_instance_t {
     size_t chunksz;                     /* Chunks size of pool member     */
     size_t chunk_count;                 /* A number of chunks in the pool */
-    struct bi_list_node_t chunks_list;  /* Chunk list head in pool        */
-    uint8_t chunks[];                   /* Data indicator                 */
+    size_t chunk_stride;                /* Distance between two chunks    */
+    uint32_t stride_shift;              /*
+                                         * log2(chunk_stride) if the stride
+                                         * is a power of two, 0 otherwise
+                                         */
+    uint8_t *chunks;                    /* First chunk in pool            */
+    struct tfm_pool_stats_t stats;      /* Usage statistics               */
+    uint32_t bitmap[];                  /* Free chunks bitmap             */
 };
 
 /*
@@ -34,16 +60,16 @@ struct tfm_pool_instance_t {
  *  num         -   Number of chunks
  */
 #define TFM_POOL_DECLARE(name, chunksz, num)                                \
-    static uint8_t name##_pool_buf[((chunksz) +                             \
-                                   sizeof(struct tfm_pool_chunk_t)) * (num) \
-                                   + sizeof(struct tfm_pool_instance_t)]    \
-                                   __attribute__((aligned(4)));             \
+    static uint8_t name##_pool_buf[sizeof(struct tfm_pool_instance_t) +     \
+                            TFM_POOL_BITMAP_WORDS(num) * sizeof(uint32_t) + \
+                            TFM_POOL_CHUNK_STRIDE(chunksz) * (num)]         \
+                            __attribute__((aligned(4)));                    \
     static struct tfm_pool_instance_t *name =                               \
                             (struct tfm_pool_instance_t *)name##_pool_buf
 
 /* Get the head size of memory pool */
-#define POOL_HEAD_SIZE (sizeof(struct tfm_pool_instance_t) +                \
-                        sizeof(struct tfm_pool_chunk_t))
+#define POOL_HEAD_SIZE(num) (sizeof(struct tfm_pool_instance_t) +           \
+                             TFM_POOL_BITMAP_WORDS(num) * sizeof(uint32_t))
 
 /* Get the whole size of memory pool */
 #define POOL_BUFFER_SIZE(name)          sizeof(name##_pool_buf)
@@ -70,6 +96,10 @@ int32_t tfm_pool_init(struct tfm_pool_instance_t *pool, size_t poolsz,
  *
  * \retval buffer pointer       Success.
  * \retval NULL                 Failed.
+ *
+ * \note This function does not mask interrupts on architectures providing
+ *       exclusive access instructions, it can be called from both thread
+ *       and handler mode.
  */
 void *tfm_pool_alloc(struct tfm_pool_instance_t *pool);
 
@@ -79,20 +109,36 @@ void *tfm_pool_alloc(struct tfm_pool_instance_t *pool);
  * \param[in] pool              pool pointer decleared by \ref TFM_POOL_DECLARE
  *
  * \param[in] ptr               Buffer pointer want to free.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    The pointer is not a chunk of the pool, or the
+ *                              chunk is already free.
  */
 void tfm_pool_free(struct tfm_pool_instance_t *pool, void *ptr);
 
 /**
- * \brief Checks whether a pointer points to a chunk data in the pool.
+ * \brief Checks whether a pointer points to an allocated chunk data in the
+ *        pool.
  *
  * \param[in] pool              Pointer to memory pool declared by
  *                              \ref TFM_POOL_DECLARE.
  * \param[in] data              The pointer to check.
  *
- * \retval true                 Data is a chunk data in the pool.
- * \retval false                Data is not a chunk data in the pool.
+ * \retval true                 Data is an allocated chunk data in the pool.
+ * \retval false                Data is not a chunk data in the pool, or the
+ *                              chunk is free.
  */
 bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
                                  uint8_t *data);
 
+/**
+ * \brief Get a snapshot of the usage statistics of a pool.
+ *
+ * \param[in]  pool             Pointer to memory pool declared by
+ *                              \ref TFM_POOL_DECLARE.
+ * \param[out] stats            Buffer to hold the statistics.
+ */
+void tfm_pool_get_stats(const struct tfm_pool_instance_t *pool,
+                        struct tfm_pool_stats_t *stats);
+
 #endif /* __TFM_POOLS_H__ */
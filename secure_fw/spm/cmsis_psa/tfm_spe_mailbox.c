@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,15 +10,57 @@
 #include "cmsis_compiler.h"
 
 #include "psa/error.h"
+#include "tfm_arch.h"
 #include "tfm_core_utils.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
 #include "utilities.h"
 #include "tfm_spe_mailbox.h"
 #include "tfm_rpc.h"
 
 #define NS_CALLER_FLAG          (true)
 
+/*
+ * A message handle holds the SPE mailbox queue slot index plus one, and a
+ * sequence number which tells a stale handle of a reused slot.
+ */
+#define MSG_HANDLE_IDX_MASK     (0xFFUL)
+#define MSG_HANDLE_SEQ_POS      (8)
+#define MSG_HANDLE_SEQ_MASK     (0x7FFFFFUL)
+
 static struct secure_mailbox_queue_t spe_mailbox_queue;
 
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+/* SPE statistics in NSPE mailbox queue */
+#define SPE_STATS()             (&spe_mailbox_queue.ns_queue->stats.spe)
+
+static void mailbox_stats_fetch(uint8_t idx)
+{
+    uint32_t call_type = spe_mailbox_queue.queue[idx].msg.call_type;
+
+    spe_mailbox_queue.queue[idx].fetch_time = tfm_hal_get_timestamp();
+
+    if ((call_type >= 1) && (call_type <= MAILBOX_STATS_CALL_TYPE_NUM)) {
+        SPE_STATS()->nr_msgs[call_type - 1]++;
+    }
+}
+
+static void mailbox_stats_reply(uint8_t idx)
+{
+    mailbox_stats_hist_add(SPE_STATS()->proc_hist,
+                           tfm_hal_get_timestamp() -
+                           spe_mailbox_queue.queue[idx].fetch_time);
+}
+
+#define mailbox_stats_doorbell_rx()     (SPE_STATS()->nr_doorbell_rx++)
+#define mailbox_stats_doorbell_tx()     (SPE_STATS()->nr_doorbell_tx++)
+#else /* TFM_MULTI_CORE_MAILBOX_STATS */
+#define mailbox_stats_fetch(idx)        do {} while (0)
+#define mailbox_stats_reply(idx)        do {} while (0)
+#define mailbox_stats_doorbell_rx()     do {} while (0)
+#define mailbox_stats_doorbell_tx()     do {} while (0)
+#endif /* TFM_MULTI_CORE_MAILBOX_STATS */
+
 static int32_t tfm_mailbox_dispatch(uint32_t call_type,
                                     const struct psa_client_params_t *params,
                                     int32_t client_id,
@@ -60,83 +104,79 @@ static int32_t tfm_mailbox_dispatch(uint32_t call_type,
     }
 }
 
-__STATIC_INLINE void set_spe_queue_empty_status(uint8_t idx)
+__STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
+                                                   mailbox_msg_handle_t *handle)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        spe_mailbox_queue.empty_slots |= (1 << idx);
-    }
-}
+    uint32_t seq;
 
-__STATIC_INLINE void clear_spe_queue_empty_status(uint8_t idx)
-{
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        spe_mailbox_queue.empty_slots &= ~(1 << idx);
-    }
-}
-
-__STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
-{
-    if ((idx < NUM_MAILBOX_QUEUE_SLOT) &&
-        (spe_mailbox_queue.empty_slots & (1 << idx))) {
-        return true;
+    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) || !handle) {
+        return MAILBOX_INVAL_PARAMS;
     }
 
-    return false;
-}
+    seq = ++spe_mailbox_queue.handle_seq & MSG_HANDLE_SEQ_MASK;
+    *handle = (mailbox_msg_handle_t)((seq << MSG_HANDLE_SEQ_POS) |
+                                     (uint32_t)(idx + 1));
 
-__STATIC_INLINE mailbox_queue_status_t get_nspe_queue_pend_status(
-                                    const struct ns_mailbox_queue_t *ns_queue)
-{
-    return ns_queue->pend_slots;
+    return MAILBOX_SUCCESS;
 }
 
-__STATIC_INLINE void set_nspe_queue_replied_status(
-                                            struct ns_mailbox_queue_t *ns_queue,
-                                            mailbox_queue_status_t mask)
+__STATIC_INLINE int32_t get_spe_mailbox_msg_idx(mailbox_msg_handle_t handle,
+                                                uint8_t *idx)
 {
-    ns_queue->replied_slots |= mask;
-}
+    uint32_t slot_idx;
 
-__STATIC_INLINE void clear_nspe_queue_pend_status(
-                                            struct ns_mailbox_queue_t *ns_queue,
-                                            mailbox_queue_status_t mask)
-{
-    ns_queue->pend_slots &= ~mask;
-}
+    if ((handle == MAILBOX_MSG_NULL_HANDLE) || !idx) {
+        return MAILBOX_INVAL_PARAMS;
+    }
 
-__STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
-                                                   mailbox_msg_handle_t *handle)
-{
-    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) || !handle) {
+    slot_idx = ((uint32_t)handle & MSG_HANDLE_IDX_MASK) - 1;
+    if (slot_idx >= NUM_MAILBOX_QUEUE_SLOT) {
         return MAILBOX_INVAL_PARAMS;
     }
 
-    *handle = (mailbox_msg_handle_t)(idx + 1);
+    /* The slot may have been released and reused by another message */
+    if (!spe_mailbox_queue.queue[slot_idx].is_used ||
+        (spe_mailbox_queue.queue[slot_idx].msg_handle != handle)) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    *idx = (uint8_t)slot_idx;
 
     return MAILBOX_SUCCESS;
 }
 
-__STATIC_INLINE int32_t get_spe_mailbox_msg_idx(mailbox_msg_handle_t handle,
-                                                uint8_t *idx)
+/* Return NUM_MAILBOX_QUEUE_SLOT if there is no free slot */
+static uint8_t mailbox_alloc_queue_slot(uint8_t ns_slot_idx)
 {
-    if ((handle == MAILBOX_MSG_NULL_HANDLE) || !idx) {
-        return MAILBOX_INVAL_PARAMS;
+    uint8_t idx;
+
+    if (!spe_mailbox_queue.nr_free) {
+        return NUM_MAILBOX_QUEUE_SLOT;
     }
 
-    *idx = (uint8_t)(handle - 1);
+    idx = spe_mailbox_queue.free_slots[--spe_mailbox_queue.nr_free];
 
-    return MAILBOX_SUCCESS;
+    spe_mailbox_queue.queue[idx].is_used = true;
+    spe_mailbox_queue.queue[idx].ns_slot_idx = ns_slot_idx;
+    spe_mailbox_queue.ns_slot_pend[ns_slot_idx] = true;
+
+    return idx;
 }
 
 static void mailbox_clean_queue_slot(uint8_t idx)
 {
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) ||
+        !spe_mailbox_queue.queue[idx].is_used) {
         return;
     }
 
+    spe_mailbox_queue.ns_slot_pend[spe_mailbox_queue.queue[idx].ns_slot_idx] =
+                                                                          false;
+
     spm_memset(&spe_mailbox_queue.queue[idx], 0,
                          sizeof(spe_mailbox_queue.queue[idx]));
-    set_spe_queue_empty_status(idx);
+
+    spe_mailbox_queue.free_slots[spe_mailbox_queue.nr_free++] = idx;
 }
 
 __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
@@ -156,6 +196,9 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 {
     struct mailbox_reply_t *reply_ptr;
     uint32_t ret_result = result;
+    uint8_t ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
+
+    mailbox_stats_reply(idx);
 
     /* Get reply address */
     reply_ptr = get_nspe_reply_addr(idx);
@@ -165,9 +208,12 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
     mailbox_clean_queue_slot(idx);
 
     /*
-     * Skip NSPE queue status update after single reply.
-     * Update NSPE queue status after all the mailbox messages are completed
+     * SPM handlers never preempt each other, so SPE is the single producer of
+     * the completion ring. Each NSPE slot is pending at most once, so the ring
+     * never overflows. The caller notifies NSPE.
      */
+    (void)mailbox_ring_push(&spe_mailbox_queue.ns_queue->cpl_ring,
+                            ns_slot_idx);
 }
 
 __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
@@ -180,54 +226,40 @@ __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
     return MAILBOX_SUCCESS;
 }
 
-int32_t tfm_mailbox_handle_msg(void)
+/* Handle a mailbox message. Return true if it is replied immediately. */
+static bool mailbox_handle_queue_slot(struct ns_mailbox_queue_t *ns_queue,
+                                      uint8_t ns_slot_idx)
 {
     uint8_t idx;
     int32_t result;
     psa_status_t psa_ret = PSA_ERROR_GENERIC_ERROR;
-    mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
-    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
     struct mailbox_msg_t *msg_ptr;
 
-    TFM_CORE_ASSERT(ns_queue != NULL);
-
-    tfm_mailbox_hal_enter_critical();
-
-    /* Check if NSPE mailbox did assert a PSA client call request */
-    if (!ns_queue->pend_slots) {
-        tfm_mailbox_hal_exit_critical();
-        return MAILBOX_NO_PEND_EVENT;
+    /*
+     * The ring content is written by NSPE. Drop an index out of range or of a
+     * slot which is still under processing.
+     */
+    if ((ns_slot_idx >= NUM_MAILBOX_QUEUE_SLOT) ||
+        spe_mailbox_queue.ns_slot_pend[ns_slot_idx]) {
+        return false;
     }
 
-    pend_slots = get_nspe_queue_pend_status(ns_queue);
-
-    tfm_mailbox_hal_exit_critical();
-
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        mask_bits = (1 << idx);
-        /* Check if current NSPE mailbox queue slot is pending for handling */
-        if (!(pend_slots & mask_bits)) {
-            continue;
-        }
-
-        /*
-         * TODO
-         * The operations are simplified here. Use the SPE mailbox queue
-         * slot with the same idx as that of the NSPE mailbox queue slot.
-         * A more general implementation should dynamically search and
-         * select an empty SPE mailbox queue slot.
-         */
-        clear_spe_queue_empty_status(idx);
-        spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
+    /*
+     * An SPE slot is held until the message completes, in any order. There
+     * are as many SPE slots as NSPE ones, so a pending NSPE slot always gets
+     * one.
+     */
+    idx = mailbox_alloc_queue_slot(ns_slot_idx);
+    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+        return false;
+    }
 
-        msg_ptr = &spe_mailbox_queue.queue[idx].msg;
-        spm_memcpy(msg_ptr, &ns_queue->queue[idx].msg, sizeof(*msg_ptr));
+    msg_ptr = &spe_mailbox_queue.queue[idx].msg;
+    spm_memcpy(msg_ptr, &ns_queue->queue[ns_slot_idx].msg, sizeof(*msg_ptr));
 
-        if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
+    mailbox_stats_fetch(idx);
 
+    if (check_mailbox_msg(msg_ptr) == MAILBOX_SUCCESS) {
         get_spe_mailbox_msg_handle(idx,
                                    &spe_mailbox_queue.queue[idx].msg_handle);
 
@@ -240,52 +272,101 @@ int32_t tfm_mailbox_handle_msg(void)
 
         result = tfm_mailbox_dispatch(msg_ptr->call_type, &msg_ptr->params,
                                       msg_ptr->client_id, &psa_ret);
-        if (result != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
 
         /* Clean up the current slot index under processing */
         spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
 
-        if ((msg_ptr->call_type == MAILBOX_PSA_FRAMEWORK_VERSION) ||
-            (msg_ptr->call_type == MAILBOX_PSA_VERSION)) {
-            /*
-             * Directly write the result to NSPE for psa_framework_version() and
-             * psa_version().
-             */
-            reply_slots |= (1 << idx);
-
-            mailbox_direct_reply(idx, (uint32_t)psa_ret);
-        } else if ((msg_ptr->call_type == MAILBOX_PSA_CONNECT) ||
-                   (msg_ptr->call_type == MAILBOX_PSA_CALL)) {
-            /*
-             * If it failed to deliver psa_connect() or psa_call() request to
-             * TF-M IPC SPM, the failure result should be returned immediately.
-             */
-            if (psa_ret != PSA_SUCCESS) {
-                reply_slots |= (1 << idx);
-                mailbox_direct_reply(idx, (uint32_t)psa_ret);
-            }
+        if (result != MAILBOX_SUCCESS) {
+            psa_ret = PSA_ERROR_GENERIC_ERROR;
         }
-        /*
-         * Skip checking psa_call() since it neither returns immediately nor
-         * has return value.
-         */
     }
 
-    tfm_mailbox_hal_enter_critical();
+    /*
+     * SPM replies a message only if it is delivered to a partition. Otherwise,
+     * such as psa_framework_version(), psa_version(), a rejected psa_connect()
+     * or psa_call(), psa_close() of an invalid handle, or a malformed message,
+     * the result is returned immediately, so that both the SPE and the NSPE
+     * slots are released.
+     */
+    if (!spe_mailbox_queue.queue[idx].is_delivered) {
+        mailbox_direct_reply(idx, (uint32_t)psa_ret);
+        return true;
+    }
+
+    return false;
+}
+
+int32_t tfm_mailbox_handle_msg(void)
+{
+    uint8_t idx;
+    uint32_t head, tail, nr_req;
+    bool is_replied = false;
+    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
+
+    TFM_CORE_ASSERT(ns_queue != NULL);
 
-    /* Clean the NSPE mailbox pending status. */
-    clear_nspe_queue_pend_status(ns_queue, pend_slots);
+    mailbox_stats_doorbell_rx();
 
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_queue, reply_slots);
+    /*
+     * The request ring indices live in NSPE memory. SPE consumes the ring from
+     * its private tail, against a single snapshot of the head, so that NSPE
+     * cannot keep SPE in this handler by corrupting or moving the head.
+     */
+    head = ns_queue->req_ring.head.idx;
+    tail = spe_mailbox_queue.req_tail;
+    if (!mailbox_ring_idx_is_valid(head)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
 
-    tfm_mailbox_hal_exit_critical();
+    nr_req = mailbox_ring_count(head, tail);
+    if (!nr_req) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
 
-    if (reply_slots) {
+    /* More requests than slots. NSPE has corrupted the ring. */
+    if (nr_req > NUM_MAILBOX_QUEUE_SLOT) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /*
+     * NSPE can skip the notification of requests pushed while SPE is draining
+     * the request ring. Those requests are caught by the check below.
+     */
+    mailbox_ring_disable_notify(&ns_queue->req_ring);
+
+    /* Read the entries only after the head */
+    MAILBOX_MEM_BARRIER();
+
+    while (nr_req--) {
+        idx = ns_queue->req_ring.entries[tail % NUM_MAILBOX_QUEUE_SLOT];
+
+        tail = mailbox_ring_next(tail);
+        spe_mailbox_queue.req_tail = tail;
+        /* Publish the tail so that NSPE can reuse the entry */
+        ns_queue->req_ring.tail.idx = tail;
+
+        if (mailbox_handle_queue_slot(ns_queue, idx)) {
+            is_replied = true;
+        }
+    }
+
+    /*
+     * At most one ring of requests is handled per notification. The requests
+     * pushed meanwhile are deferred to another run of this handler, as if
+     * NSPE had notified SPE again.
+     */
+    (void)mailbox_ring_enable_notify(&ns_queue->req_ring);
+    if (ns_queue->req_ring.head.idx != spe_mailbox_queue.req_tail) {
+        tfm_arch_trigger_pendsv();
+    }
+
+    /*
+     * Notify NSPE once for all the replies in this batch, unless NSPE is
+     * draining or polling the completion ring.
+     */
+    if (is_replied && mailbox_ring_need_notify(&ns_queue->cpl_ring)) {
         tfm_mailbox_hal_notify_peer();
+        mailbox_stats_doorbell_tx();
     }
 
     return MAILBOX_SUCCESS;
@@ -300,34 +381,20 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
     TFM_CORE_ASSERT(ns_queue != NULL);
 
     /*
-     * If handle == MAILBOX_MSG_NULL_HANDLE, reply to the mailbox message
-     * in the first slot.
-     * When multiple ongoing PSA client calls from NSPE are supported,
-     * additional check might be necessary to avoid spoofing the first slot.
+     * The slots are allocated dynamically. A message cannot be identified
+     * without its handle.
      */
-    if (handle == MAILBOX_MSG_NULL_HANDLE) {
-        idx = 0;
-    } else {
-        ret = get_spe_mailbox_msg_idx(handle, &idx);
-        if (ret != MAILBOX_SUCCESS) {
-            return ret;
-        }
-    }
-
-    if (get_spe_queue_empty_status(idx)) {
-        return MAILBOX_NO_PEND_EVENT;
+    ret = get_spe_mailbox_msg_idx(handle, &idx);
+    if (ret != MAILBOX_SUCCESS) {
+        return ret;
     }
 
     mailbox_direct_reply(idx, (uint32_t)reply);
 
-    tfm_mailbox_hal_enter_critical();
-
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_queue, (1 << idx));
-
-    tfm_mailbox_hal_exit_critical();
-
-    tfm_mailbox_hal_notify_peer();
+    if (mailbox_ring_need_notify(&ns_queue->cpl_ring)) {
+        tfm_mailbox_hal_notify_peer();
+        mailbox_stats_doorbell_tx();
+    }
 
     return MAILBOX_SUCCESS;
 }
@@ -341,14 +408,8 @@ static void mailbox_handle_req(void)
 /* RPC reply() callback */
 static void mailbox_reply(const void *owner, int32_t ret)
 {
-    mailbox_msg_handle_t handle = MAILBOX_MSG_NULL_HANDLE;
-
-    /* If the owner is specified */
-    if (owner) {
-        handle = *((mailbox_msg_handle_t *)owner);
-    }
-
-    (void)tfm_mailbox_reply_msg(handle, ret);
+    /* The owner carries the message handle by value */
+    (void)tfm_mailbox_reply_msg((mailbox_msg_handle_t)(uintptr_t)owner, ret);
 }
 
 /* RPC get_caller_data() callback */
@@ -359,13 +420,83 @@ static const void *mailbox_get_caller_data(int32_t client_id)
     (void)client_id;
 
     idx = spe_mailbox_queue.cur_proc_slot_idx;
+    /*
+     * Pass the handle by value, rather than the address of the slot, so that a
+     * reply to a released slot is detected.
+     */
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        return (const void *)&spe_mailbox_queue.queue[idx].msg_handle;
+        /* SPM sets the caller data only when it queues the message */
+        spe_mailbox_queue.queue[idx].is_delivered = true;
+        return (const void *)(uintptr_t)spe_mailbox_queue.queue[idx].msg_handle;
     }
 
     return NULL;
 }
 
+/*
+ * Validate the NSPE shared buffer arena once. The arena descriptor is copied
+ * into secure memory, so that NSPE cannot change it later.
+ */
+static void mailbox_arena_init(const struct ns_mailbox_queue_t *ns_queue)
+{
+    uintptr_t base = ns_queue->arena_base;
+    size_t size = ns_queue->arena_size;
+
+    if (!size || (base % MAILBOX_CACHE_LINE_SIZE) ||
+        (base > (UINTPTR_MAX - size)) ||
+        (tfm_hal_memory_has_access(base, size,
+                                   TFM_HAL_ACCESS_NS |
+                                   TFM_HAL_ACCESS_UNPRIVILEGED |
+                                   TFM_HAL_ACCESS_READABLE |
+                                   TFM_HAL_ACCESS_WRITABLE) !=
+         TFM_HAL_SUCCESS)) {
+        return;
+    }
+
+    spe_mailbox_queue.arena_base = base;
+    spe_mailbox_queue.arena_size = size;
+}
+
+bool tfm_mailbox_is_arena_buf(const void *buf, size_t len)
+{
+    uintptr_t offset;
+
+    /* A true result skips the memory access check of the buffer */
+    if (!spe_mailbox_queue.arena_size || !buf || !len) {
+        return false;
+    }
+
+    if ((uintptr_t)buf > (UINTPTR_MAX - len)) {
+        return false;
+    }
+
+    if (((uintptr_t)buf < spe_mailbox_queue.arena_base) ||
+        (len > spe_mailbox_queue.arena_size)) {
+        return false;
+    }
+
+    offset = (uintptr_t)buf - spe_mailbox_queue.arena_base;
+
+    return offset <= spe_mailbox_queue.arena_size - len;
+}
+
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+int32_t tfm_mailbox_get_stats(struct mailbox_stats_t *stats)
+{
+    if (!stats) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    if (!spe_mailbox_queue.ns_queue) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    spm_memcpy(stats, &spe_mailbox_queue.ns_queue->stats, sizeof(*stats));
+
+    return MAILBOX_SUCCESS;
+}
+#endif
+
 /* Mailbox specific operations callback for TF-M RPC */
 static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
     .handle_req = mailbox_handle_req,
@@ -376,13 +507,15 @@ static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
 int32_t tfm_mailbox_init(void)
 {
     int32_t ret;
+    uint8_t idx;
 
     spm_memset(&spe_mailbox_queue, 0, sizeof(spe_mailbox_queue));
 
-    spe_mailbox_queue.empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
-    spe_mailbox_queue.empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        spe_mailbox_queue.free_slots[idx] = idx;
+    }
+    spe_mailbox_queue.nr_free = NUM_MAILBOX_QUEUE_SLOT;
+    spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
 
     /* Register RPC callbacks */
     ret = tfm_rpc_register_ops(&mailbox_rpc_ops);
@@ -402,5 +535,7 @@ int32_t tfm_mailbox_init(void)
         return ret;
     }
 
+    mailbox_arena_init(spe_mailbox_queue.ns_queue);
+
     return MAILBOX_SUCCESS;
 }
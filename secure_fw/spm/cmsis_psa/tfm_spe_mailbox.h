@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -20,14 +22,55 @@ struct secure_mailbox_slot_t {
     struct mailbox_msg_t msg;
 
     uint8_t              ns_slot_idx;
+    bool                 is_used;           /* The slot is under processing */
+    bool                 is_delivered;      /*
+                                             * The message is delivered to a
+                                             * partition, which replies it.
+                                             */
     mailbox_msg_handle_t msg_handle;
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+    uint32_t             fetch_time;        /* When the message is fetched */
+#endif
 };
 
+/*
+ * SPE mailbox queue. The slots are allocated independently of the NSPE mailbox
+ * queue slots, and are released in any order when the messages complete.
+ * An SPE slot is held only while its NSPE slot is pending, so at most
+ * NUM_MAILBOX_QUEUE_SLOT slots are outstanding. A message which is not
+ * delivered to a partition is replied, and its slot released, before the
+ * request handler returns. A delivered message is always replied by SPM.
+ */
 struct secure_mailbox_queue_t {
-    mailbox_queue_status_t       empty_slots;      /* bitmask of empty slots */
-
     struct secure_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
+    uint8_t                      free_slots[NUM_MAILBOX_QUEUE_SLOT];
+                                                    /* Stack of free slot
+                                                     * indices
+                                                     */
+    uint8_t                      nr_free;           /* Number of free slots */
+    bool                         ns_slot_pend[NUM_MAILBOX_QUEUE_SLOT];
+                                                    /*
+                                                     * Whether an NSPE mailbox
+                                                     * queue slot is under
+                                                     * processing.
+                                                     */
+    uint32_t                     handle_seq;        /*
+                                                     * Sequence number of the
+                                                     * latest message handle
+                                                     */
     struct ns_mailbox_queue_t    *ns_queue;
+    uint32_t                     req_tail;          /*
+                                                     * Consumer index of the
+                                                     * request ring. NSPE can
+                                                     * overwrite the copy in
+                                                     * its queue.
+                                                     */
+    uintptr_t                    arena_base;        /*
+                                                     * NSPE shared buffer arena
+                                                     * validated during
+                                                     * initialization
+                                                     */
+    size_t                       arena_size;
     uint8_t                      cur_proc_slot_idx; /*
                                                      * The index of mailbox
                                                      * queue slot currently
@@ -55,6 +98,34 @@ int32_t tfm_mailbox_handle_msg(void);
  */
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply);
 
+/**
+ * \brief Check whether a buffer is inside the NSPE shared buffer arena.
+ *        The arena has been validated for non-secure read-write access during
+ *        SPE mailbox initialization.
+ *
+ * \param[in] buf               The base address of the buffer
+ * \param[in] len               The length of the buffer in bytes
+ *
+ * \return true if the buffer is inside the arena, otherwise false. Always
+ *         false if there is no arena, if \a buf is NULL or \a len is 0, or if
+ *         the buffer wraps around the address space.
+ */
+bool tfm_mailbox_is_arena_buf(const void *buf, size_t len);
+
+#ifdef TFM_MULTI_CORE_MAILBOX_STATS
+/**
+ * \brief Read the mailbox statistics collected by NSPE and SPE.
+ *
+ * \note The statistics are kept in NSPE mailbox queue. NSPE can modify them.
+ *
+ * \param[out] stats            The buffer to be written with the statistics.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_mailbox_get_stats(struct mailbox_stats_t *stats);
+#endif
+
 /**
  * \brief SPE mailbox initialization
  *
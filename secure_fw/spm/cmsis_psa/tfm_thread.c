@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,21 +13,51 @@
 #include "tfm_memory_utils.h"
 #include "tfm/tfm_core_svc.h"
 #include "tfm_core_utils.h"
+#ifdef TFM_SPM_DEBUG_STATS
+#include "tfm_hal_platform.h"
+#endif
 
 /* Force ZERO in case ZI(bss) clear is missing */
 static struct tfm_core_thread_t *p_thrd_head = NULL; /* Head of all threads */
 static struct tfm_core_thread_t *p_rnbl_head = NULL; /* Head of runnable */
 static struct tfm_core_thread_t *p_curr_thrd = NULL; /* Current running */
+static struct tfm_core_thread_t *p_hoff_thrd = NULL; /* Direct handoff */
 
 /* Define Macro to fetch global to support future expansion (PERCPU e.g.) */
 #define LIST_HEAD   p_thrd_head
 #define RNBL_HEAD   p_rnbl_head
 #define CURR_THRD   p_curr_thrd
+#define HOFF_THRD   p_hoff_thrd
+
+#ifdef TFM_SPM_DEBUG_STATS
+/* Timestamp of the latest context switch */
+static uint32_t last_switch_time;
+#endif
 
 /* Get next thread to run for scheduler */
 struct tfm_core_thread_t *tfm_core_thrd_get_next(void)
 {
     struct tfm_core_thread_t *pth = RNBL_HEAD;
+    struct tfm_core_thread_t *hoff = HOFF_THRD;
+
+    HOFF_THRD = NULL;
+
+    /*
+     * Run the handoff thread unless a thread of higher priority is runnable.
+     * Only threads of higher priority need to be scanned for that.
+     */
+    if (hoff && hoff->state == THRD_STATE_RUNNABLE) {
+        while (pth && pth->prior < hoff->prior &&
+               pth->state != THRD_STATE_RUNNABLE) {
+            pth = pth->next;
+        }
+
+        if (!pth || pth->prior >= hoff->prior) {
+            return hoff;
+        }
+
+        return pth;
+    }
 
     /*
      * First runnable thread has highest priority since threads are sorted with
@@ -116,6 +148,35 @@ void tfm_core_thrd_set_state(struct tfm_core_thread_t *pth, uint32_t new_state)
     }
 }
 
+void tfm_core_thrd_change_priority(struct tfm_core_thread_t *pth,
+                                   uint32_t prior)
+{
+    struct tfm_core_thread_t **pp = &LIST_HEAD;
+
+    TFM_CORE_ASSERT(pth != NULL);
+
+    /* Unlink the thread and insert it again to keep the list sorted */
+    while (*pp && *pp != pth) {
+        pp = &(*pp)->next;
+    }
+
+    TFM_CORE_ASSERT(*pp == pth);
+
+    *pp = pth->next;
+    tfm_core_thrd_set_priority(pth, prior);
+    insert_by_prior(&LIST_HEAD, pth);
+
+    /* Runnable threads may now come before the old head, search from start */
+    RNBL_HEAD = LIST_HEAD;
+
+    tfm_core_thrd_activate_schedule();
+}
+
+void tfm_core_thrd_set_handoff(struct tfm_core_thread_t *pth)
+{
+    HOFF_THRD = pth;
+}
+
 /* Scheduling won't happen immediately but after the exception returns */
 void tfm_core_thrd_activate_schedule(void)
 {
@@ -138,6 +199,10 @@ void tfm_core_thrd_start_scheduler(struct tfm_core_thread_t *pth)
 
     CURR_THRD = pth;
 
+#ifdef TFM_SPM_DEBUG_STATS
+    last_switch_time = tfm_hal_get_timestamp();
+#endif
+
     tfm_core_thrd_activate_schedule();
 }
 
@@ -145,9 +210,21 @@ void tfm_core_thrd_switch_context(struct tfm_arch_ctx_t *p_actx,
                                   struct tfm_core_thread_t *prev,
                                   struct tfm_core_thread_t *next)
 {
+#ifdef TFM_SPM_DEBUG_STATS
+    uint32_t now;
+#endif
+
     TFM_CORE_ASSERT(prev != NULL);
     TFM_CORE_ASSERT(next != NULL);
 
+#ifdef TFM_SPM_DEBUG_STATS
+    /* Handler time is accounted to the thread it interrupted */
+    now = tfm_hal_get_timestamp();
+    prev->run_time += (uint32_t)(now - last_switch_time);
+    next->run_count++;
+    last_switch_time = now;
+#endif
+
     /*
      * First, update latest context into the current thread context.
      * Then, update background context with next thread's context.
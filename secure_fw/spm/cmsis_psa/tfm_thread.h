@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -48,6 +50,10 @@ struct tfm_core_thread_t {
 
     struct tfm_arch_ctx_t    arch_ctx;  /* State context                */
     struct tfm_core_thread_t *next;     /* next thread in list          */
+#ifdef TFM_SPM_DEBUG_STATS
+    uint64_t        run_time;           /* time run, in timestamp ticks */
+    uint32_t        run_count;          /* times switched in            */
+#endif
 };
 
 /*
@@ -86,6 +92,20 @@ __STATIC_INLINE void tfm_core_thrd_set_priority(struct tfm_core_thread_t *pth,
     pth->prior |= prior & THRD_PRIOR_MASK;
 }
 
+/*
+ * Change the priority of a started thread.
+ *
+ * Parameters :
+ *  pth         -     pointer of thread context
+ *  prior       -     priority value (0~255)
+ *
+ * Notes :
+ *  Unlike tfm_core_thrd_set_priority(), this function keeps the thread list
+ *  sorted by priority and triggers a scheduling action.
+ */
+void tfm_core_thrd_change_priority(struct tfm_core_thread_t *pth,
+                                   uint32_t prior);
+
 /*
  * Set thread security attribute.
  *
@@ -180,6 +200,20 @@ struct tfm_core_thread_t *tfm_core_thrd_get_curr(void);
  */
 struct tfm_core_thread_t *tfm_core_thrd_get_next(void);
 
+/*
+ * Hint the scheduler to run a thread next.
+ *
+ * Parameters :
+ *  pth         -     thread to run next, NULL to drop the hint
+ *
+ * Notes :
+ *  The hint is taken by the next scheduling action if the thread is
+ *  runnable then and no runnable thread has a higher priority. It saves
+ *  the scan for a runnable thread when a caller hands the CPU over to a
+ *  thread it has just woken up.
+ */
+void tfm_core_thrd_set_handoff(struct tfm_core_thread_t *pth);
+
 /*
  * Start scheduler for existing threads
  *
@@ -22,6 +22,7 @@
 #include "ffm/spm_error_base.h"
 #include "tfm_rpc.h"
 #include "tfm_spm_hal.h"
+#include "tfm_spm_trace.h"
 
 /*********************** SPM functions for PSA Client APIs *******************/
 
@@ -234,6 +235,9 @@ psa_status_t tfm_spm_psa_get(uint32_t *args)
 
     spm_memcpy(msg, &tmp_msg->msg, sizeof(psa_msg_t));
 
+    SPM_TRACE(TFM_SPM_TRACE_EVT_GET, tmp_msg->service->service_db->sid,
+              tmp_msg->msg.client_id);
+
     return PSA_SUCCESS;
 }
 
@@ -309,6 +313,18 @@ size_t tfm_spm_psa_read(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    /*
+     * It is a fatal error if the input vector has already been mapped using
+     * psa_map_invec().
+     */
+    if (IOVEC_IS_MAPPED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    SET_IOVEC_ACCESSED(msg, (invec_idx + INVEC_IDX_BASE));
+#endif
+
     /* There was no remaining data in this input vector */
     if (msg->msg.in_size[invec_idx] == 0) {
         return 0;
@@ -369,6 +385,18 @@ size_t tfm_spm_psa_skip(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    /*
+     * It is a fatal error if the input vector has already been mapped using
+     * psa_map_invec().
+     */
+    if (IOVEC_IS_MAPPED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    SET_IOVEC_ACCESSED(msg, (invec_idx + INVEC_IDX_BASE));
+#endif
+
     /* There was no remaining data in this input vector */
     if (msg->msg.in_size[invec_idx] == 0) {
         return 0;
@@ -432,6 +460,18 @@ void tfm_spm_psa_write(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    /*
+     * It is a fatal error if the output vector has already been mapped using
+     * psa_map_outvec().
+     */
+    if (IOVEC_IS_MAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    SET_IOVEC_ACCESSED(msg, (outvec_idx + OUTVEC_IDX_BASE));
+#endif
+
     /*
      * It is a fatal error if the call attempts to write data past the end of
      * the client output vector
@@ -457,6 +497,207 @@ void tfm_spm_psa_write(uint32_t *args)
     msg->outvec[outvec_idx].len += num_bytes;
 }
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+/*
+ * Common checks of the MM-IOVEC APIs. Returns the message referred to by
+ * 'msg_handle', or does not return if the call is invalid.
+ */
+static struct tfm_msg_body_t *spm_get_mm_iovec_msg(psa_handle_t msg_handle,
+                                                   uint32_t iovec_idx)
+{
+    struct tfm_msg_body_t *msg = NULL;
+
+    /* It is a fatal error if message handle is invalid */
+    msg = tfm_spm_get_msg_from_handle(msg_handle);
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if MM-IOVEC has not been enabled for the RoT
+     * Service that received the message.
+     */
+    if (!msg->service->service_db->mm_iovec) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (msg->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the vector index is equal to or greater than
+     * PSA_MAX_IOVEC
+     */
+    if (iovec_idx >= PSA_MAX_IOVEC) {
+        tfm_core_panic();
+    }
+
+    return msg;
+}
+
+const void *tfm_spm_psa_map_invec(uint32_t *args)
+{
+    psa_handle_t msg_handle;
+    uint32_t invec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    msg_handle = (psa_handle_t)args[0];
+    invec_idx = args[1];
+
+    msg = spm_get_mm_iovec_msg(msg_handle, invec_idx);
+
+    /* It is a fatal error if the input vector has length zero. */
+    if (msg->msg.in_size[invec_idx] == 0) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the input vector has already been mapped using
+     * psa_map_invec().
+     */
+    if (IOVEC_IS_MAPPED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the input vector has already been accessed
+     * using psa_read() or psa_skip().
+     */
+    if (IOVEC_IS_ACCESSED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * The client vector has been checked against the client's access rights
+     * in psa_call(). At isolation level 1 the Secure Partitions share the
+     * SPM's view of memory, so no further check is needed to hand the
+     * buffer out directly.
+     */
+    SET_IOVEC_MAPPED(msg, (invec_idx + INVEC_IDX_BASE));
+
+    return msg->invec[invec_idx].base;
+}
+
+void tfm_spm_psa_unmap_invec(uint32_t *args)
+{
+    psa_handle_t msg_handle;
+    uint32_t invec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    msg_handle = (psa_handle_t)args[0];
+    invec_idx = args[1];
+
+    msg = spm_get_mm_iovec_msg(msg_handle, invec_idx);
+
+    /*
+     * It is a fatal error if the input vector has not been mapped by a call to
+     * psa_map_invec().
+     */
+    if (!IOVEC_IS_MAPPED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the input vector has already been unmapped by a
+     * call to psa_unmap_invec().
+     */
+    if (IOVEC_IS_UNMAPPED(msg, (invec_idx + INVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    SET_IOVEC_UNMAPPED(msg, (invec_idx + INVEC_IDX_BASE));
+}
+
+void *tfm_spm_psa_map_outvec(uint32_t *args)
+{
+    psa_handle_t msg_handle;
+    uint32_t outvec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    msg_handle = (psa_handle_t)args[0];
+    outvec_idx = args[1];
+
+    msg = spm_get_mm_iovec_msg(msg_handle, outvec_idx);
+
+    /* It is a fatal error if the output vector has length zero. */
+    if (msg->msg.out_size[outvec_idx] == 0) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the output vector has already been mapped using
+     * psa_map_outvec().
+     */
+    if (IOVEC_IS_MAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the output vector has already been accessed
+     * using psa_write().
+     */
+    if (IOVEC_IS_ACCESSED(msg, (outvec_idx + OUTVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /* The client vector has been checked in psa_call(), see above. */
+    SET_IOVEC_MAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE));
+
+    return msg->outvec[outvec_idx].base;
+}
+
+void tfm_spm_psa_unmap_outvec(uint32_t *args)
+{
+    psa_handle_t msg_handle;
+    uint32_t outvec_idx;
+    size_t len;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    msg_handle = (psa_handle_t)args[0];
+    outvec_idx = args[1];
+    len = (size_t)args[2];
+
+    msg = spm_get_mm_iovec_msg(msg_handle, outvec_idx);
+
+    /*
+     * It is a fatal error if the output vector has not been mapped by a call
+     * to psa_map_outvec().
+     */
+    if (!IOVEC_IS_MAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the output vector has already been unmapped by a
+     * call to psa_unmap_outvec().
+     */
+    if (IOVEC_IS_UNMAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE))) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if len is greater than the output vector size.
+     */
+    if (len > msg->msg.out_size[outvec_idx]) {
+        tfm_core_panic();
+    }
+
+    SET_IOVEC_UNMAPPED(msg, (outvec_idx + OUTVEC_IDX_BASE));
+
+    /* Update the write number */
+    msg->outvec[outvec_idx].len = len;
+}
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+
 void tfm_spm_psa_reply(uint32_t *args)
 {
     psa_handle_t msg_handle;
@@ -465,6 +706,9 @@ void tfm_spm_psa_reply(uint32_t *args)
     struct tfm_msg_body_t *msg = NULL;
     int32_t ret = PSA_SUCCESS;
     struct tfm_conn_handle_t *conn_handle;
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+    uint32_t i;
+#endif
 
     TFM_CORE_ASSERT(args != NULL);
     msg_handle = (psa_handle_t)args[0];
@@ -486,6 +730,17 @@ void tfm_spm_psa_reply(uint32_t *args)
         tfm_core_panic();
     }
 
+    SPM_TRACE(TFM_SPM_TRACE_EVT_REPLY, service->service_db->sid,
+              msg->msg.client_id);
+
+#ifdef TFM_SPM_PRIORITY_INHERITANCE
+    /*
+     * Drop the priority inherited from the client replied to, before the
+     * message is freed with its handle.
+     */
+    tfm_spm_drop_inherited_priority(service->partition, msg);
+#endif
+
     /*
      * Three type of message are passed in this function: CONNECTION, REQUEST,
      * DISCONNECTION. It needs to process differently for each type.
@@ -524,6 +779,19 @@ void tfm_spm_psa_reply(uint32_t *args)
         if (msg->msg.type >= PSA_IPC_CALL) {
             /* Reply to a request message. Return values are based on status */
             ret = status;
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+            /*
+             * Output vectors still mapped at this point are unmapped by the
+             * framework, and report that zero bytes have been written.
+             */
+            for (i = 0; i < PSA_MAX_IOVEC; i++) {
+                if (IOVEC_IS_MAPPED(msg, (i + OUTVEC_IDX_BASE)) &&
+                    !IOVEC_IS_UNMAPPED(msg, (i + OUTVEC_IDX_BASE))) {
+                    SET_IOVEC_UNMAPPED(msg, (i + OUTVEC_IDX_BASE));
+                    msg->outvec[i].len = 0;
+                }
+            }
+#endif
             /*
              * The total number of bytes written to a single parameter must be
              * reported to the client by updating the len member of the
@@ -560,8 +828,11 @@ void tfm_spm_psa_reply(uint32_t *args)
     if (is_tfm_rpc_msg(msg)) {
         tfm_rpc_client_call_reply(msg, ret);
     } else {
+        /* Switch straight back to the caller blocked on the reply */
+        tfm_core_thrd_set_handoff(msg->ack_evnt.owner);
         tfm_event_wake(&msg->ack_evnt, ret);
     }
+
 }
 
 void tfm_spm_psa_notify(uint32_t *args)
@@ -593,10 +864,32 @@ void tfm_spm_psa_clear(void)
     partition->signals_asserted &= ~PSA_DOORBELL;
 }
 
+/*
+ * Acknowledge the coalesced IRQ of 'irq_signal' and return the number of
+ * assertions merged into it. The IRQ line is never disabled for a coalesced
+ * IRQ, so clear the signal and the count together with the IRQs masked.
+ */
+static uint32_t spm_take_coalesced_irq(struct partition_t *partition,
+                                       psa_signal_t irq_signal,
+                                       volatile uint32_t *p_pending)
+{
+    uint32_t pending;
+
+    __disable_irq();
+
+    pending = *p_pending;
+    *p_pending = 0;
+    partition->signals_asserted &= ~irq_signal;
+
+    __enable_irq();
+
+    return pending;
+}
+
 void tfm_spm_psa_eoi(uint32_t *args)
 {
     psa_signal_t irq_signal;
-    int32_t irq_line = 0;
+    const struct tfm_core_irq_signal_data_t *irq_data;
     struct partition_t *partition = NULL;
 
     TFM_CORE_ASSERT(args != NULL);
@@ -607,9 +900,9 @@ void tfm_spm_psa_eoi(uint32_t *args)
         tfm_core_panic();
     }
 
-    irq_line = get_irq_line_for_signal(partition->p_static->pid, irq_signal);
+    irq_data = get_irq_data_for_signal(partition->p_static->pid, irq_signal);
     /* It is a fatal error if passed signal is not an interrupt signal. */
-    if (irq_line < 0) {
+    if (!irq_data) {
         tfm_core_panic();
     }
 
@@ -618,10 +911,38 @@ void tfm_spm_psa_eoi(uint32_t *args)
         tfm_core_panic();
     }
 
+    if (irq_data->pending) {
+        (void)spm_take_coalesced_irq(partition, irq_signal, irq_data->pending);
+        return;
+    }
+
     partition->signals_asserted &= ~irq_signal;
 
-    tfm_spm_hal_clear_pending_irq((IRQn_Type)irq_line);
-    tfm_spm_hal_enable_irq((IRQn_Type)irq_line);
+    tfm_spm_hal_clear_pending_irq((IRQn_Type)irq_data->irq_line);
+    tfm_spm_hal_enable_irq((IRQn_Type)irq_data->irq_line);
+}
+
+uint32_t tfm_spm_irq_take_pending(uint32_t *args)
+{
+    psa_signal_t irq_signal;
+    const struct tfm_core_irq_signal_data_t *irq_data;
+    struct partition_t *partition = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    irq_signal = (psa_signal_t)args[0];
+
+    partition = tfm_spm_get_running_partition();
+    if (!partition) {
+        tfm_core_panic();
+    }
+
+    irq_data = get_irq_data_for_signal(partition->p_static->pid, irq_signal);
+    /* It is a fatal error if passed signal is not a coalesced IRQ signal. */
+    if (!irq_data || !irq_data->pending) {
+        tfm_core_panic();
+    }
+
+    return spm_take_coalesced_irq(partition, irq_signal, irq_data->pending);
 }
 
 void tfm_spm_psa_panic(void)
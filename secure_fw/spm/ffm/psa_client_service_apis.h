@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -208,6 +210,95 @@ size_t tfm_spm_psa_skip(uint32_t *args);
  */
 void tfm_spm_psa_write(uint32_t *args);
 
+#ifdef PSA_FRAMEWORK_HAS_MM_IOVEC
+/**
+ * \brief SVC handler for \ref psa_map_invec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, invec_idx.
+ *
+ * \retval A pointer to the input vector data.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector has length zero.
+ * \arg                           The input vector has already been mapped, or
+ *                                accessed using psa_read() or psa_skip().
+ */
+const void *tfm_spm_psa_map_invec(uint32_t *args);
+
+/**
+ * \brief SVC handler for \ref psa_unmap_invec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, invec_idx.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector has not been mapped, or has
+ *                                already been unmapped.
+ */
+void tfm_spm_psa_unmap_invec(uint32_t *args);
+
+/**
+ * \brief SVC handler for \ref psa_map_outvec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, outvec_idx.
+ *
+ * \retval A pointer to the output vector data.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector has length zero.
+ * \arg                           The output vector has already been mapped, or
+ *                                accessed using psa_write().
+ */
+void *tfm_spm_psa_map_outvec(uint32_t *args);
+
+/**
+ * \brief SVC handler for \ref psa_unmap_outvec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, outvec_idx, len.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           MM-IOVEC has not been enabled for the RoT
+ *                                Service that received the message.
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector has not been mapped, or has
+ *                                already been unmapped.
+ * \arg                           len is greater than the output vector size.
+ */
+void tfm_spm_psa_unmap_outvec(uint32_t *args);
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+
 /**
  * \brief SVC handler for \ref psa_reply.
  *
@@ -257,6 +348,22 @@ void tfm_spm_psa_clear(void);
  */
 void tfm_spm_psa_eoi(uint32_t *args);
 
+/**
+ * \brief SVC handler for \ref tfm_irq_take_pending.
+ *
+ * \param[in] args              Include all input arguments: irq_signal.
+ *
+ * \retval >=0                  Number of IRQ assertions since the previous
+ *                              acknowledgement, 0 if the signal is not
+ *                              asserted.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           irq_signal is not a coalesced interrupt
+ *                                signal.
+ * \arg                           irq_signal indicates more than one signal.
+ */
+uint32_t tfm_spm_irq_take_pending(uint32_t *args);
+
 /**
  * \brief Terminate execution within the calling Secure Partition and will not
  *        return.
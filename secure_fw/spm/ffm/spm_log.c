@@ -8,6 +8,10 @@
  */
 
 #include "tfm_spm_log.h"
+#ifdef TFM_SPM_LOG_BUFFERED
+#include "tfm_arch.h"
+#include "tfm_core_utils.h"
+#endif
 
 #define MAX_DIGIT_BITS 12  /* 8 char for number, 2 for '0x' and 2 for '\r\n' */
 static const char HEX_TABLE[] = {'0', '1', '2', '3', '4', '5', '6', '7',
@@ -35,7 +39,7 @@ static void to_hex(uint32_t value, char msg[])
     msg[i--] = '0';
 }
 
-int32_t spm_log_msgval(const char *msg, size_t len, uint32_t value)
+static int32_t log_output_msgval(const char *msg, size_t len, uint32_t value)
 {
     int32_t result_msg = 0, result_val;
     char value_str[MAX_DIGIT_BITS];
@@ -56,3 +60,211 @@ int32_t spm_log_msgval(const char *msg, size_t len, uint32_t value)
     }
     return (result_msg + result_val);
 }
+
+#ifdef TFM_SPM_LOG_BUFFERED
+
+#ifndef TFM_SPM_LOG_BUFFER_SIZE
+#define TFM_SPM_LOG_BUFFER_SIZE         1024
+#endif
+
+#if (TFM_SPM_LOG_BUFFER_SIZE & (TFM_SPM_LOG_BUFFER_SIZE - 1)) != 0 || \
+    (TFM_SPM_LOG_BUFFER_SIZE < 64)
+#error "TFM_SPM_LOG_BUFFER_SIZE must be a power of two, at least 64!"
+#endif
+
+#define LOG_BUF_MASK                    (TFM_SPM_LOG_BUFFER_SIZE - 1)
+
+/*
+ * A log record is a header word followed by the payload, padded to a multiple
+ * of 4 bytes. The payload is the string itself for LOG_REC_STR, and a
+ * struct log_ref_t for the constant messages, which are output from where
+ * they are. The header is written last, with LOG_REC_READY set.
+ */
+#define LOG_REC_READY                   (1UL << 31)
+#define LOG_REC_TYPE_POS                16
+#define LOG_REC_TYPE_MASK               (0xFUL << LOG_REC_TYPE_POS)
+#define LOG_REC_LEN_MASK                0xFFFFUL
+
+#define LOG_REC_STR                     1
+#define LOG_REC_MSG                     2
+#define LOG_REC_MSGVAL                  3
+
+#define LOG_REC_SIZE(len)               (sizeof(uint32_t) + \
+                                         (((len) + 3UL) & ~3UL))
+
+struct log_ref_t {
+    const char *msg;
+    uint32_t len;
+    uint32_t value;
+};
+
+/*
+ * The buffer positions are free running byte counters. Any context can
+ * reserve a record by moving 'log_head', while only the drain moves
+ * 'log_tail'. The drain clears the records it has output, so a header it
+ * reads is either zero or has been written for the current record.
+ */
+static uint32_t log_buf[TFM_SPM_LOG_BUFFER_SIZE / sizeof(uint32_t)];
+static volatile uint32_t log_head;
+static volatile uint32_t log_tail;
+static volatile uint32_t log_dropped;
+static uint32_t log_dropped_reported;
+
+#define LOG_REC_HDR(pos)                                                    \
+    (((volatile uint32_t *)log_buf)[((pos) & LOG_BUF_MASK) / sizeof(uint32_t)])
+
+static void log_buf_write(uint32_t pos, const void *data, uint32_t len)
+{
+    uint32_t off = pos & LOG_BUF_MASK;
+    uint32_t first = TFM_SPM_LOG_BUFFER_SIZE - off;
+
+    if (first >= len) {
+        spm_memcpy((uint8_t *)log_buf + off, data, len);
+    } else {
+        spm_memcpy((uint8_t *)log_buf + off, data, first);
+        spm_memcpy(log_buf, (const uint8_t *)data + first, len - first);
+    }
+}
+
+static void log_buf_read(uint32_t pos, void *data, uint32_t len)
+{
+    uint32_t off = pos & LOG_BUF_MASK;
+    uint32_t first = TFM_SPM_LOG_BUFFER_SIZE - off;
+
+    if (first >= len) {
+        spm_memcpy(data, (uint8_t *)log_buf + off, len);
+    } else {
+        spm_memcpy(data, (uint8_t *)log_buf + off, first);
+        spm_memcpy((uint8_t *)data + first, log_buf, len - first);
+    }
+}
+
+static void log_buf_output(uint32_t pos, uint32_t len)
+{
+    uint32_t off = pos & LOG_BUF_MASK;
+    uint32_t first = TFM_SPM_LOG_BUFFER_SIZE - off;
+
+    if (first >= len) {
+        tfm_hal_output_spm_log((const char *)log_buf + off, len);
+    } else {
+        tfm_hal_output_spm_log((const char *)log_buf + off, first);
+        tfm_hal_output_spm_log((const char *)log_buf, len - first);
+    }
+}
+
+static int32_t log_record(uint32_t type, const void *data, size_t len)
+{
+    uint32_t head, size;
+
+    if (len > LOG_REC_LEN_MASK) {
+        tfm_arch_fetch_add_u32(&log_dropped, 1);
+        return 0;
+    }
+
+    size = LOG_REC_SIZE(len);
+    do {
+        head = log_head;
+        if (size > TFM_SPM_LOG_BUFFER_SIZE - (head - log_tail)) {
+            tfm_arch_fetch_add_u32(&log_dropped, 1);
+            return 0;
+        }
+    } while (!tfm_arch_cas_u32(&log_head, head, head + size));
+
+    log_buf_write(head + sizeof(uint32_t), data, len);
+
+    /* Make the payload visible before the header */
+    __DMB();
+    LOG_REC_HDR(head) = LOG_REC_READY | (type << LOG_REC_TYPE_POS) | len;
+
+    return (int32_t)len;
+}
+
+int32_t spm_log_msg(const char *msg, size_t len)
+{
+    struct log_ref_t ref = {msg, len, 0};
+
+    if (!msg || !len) {
+        return 0;
+    }
+    if (log_record(LOG_REC_MSG, &ref, sizeof(ref)) == 0) {
+        return 0;
+    }
+    return (int32_t)len;
+}
+
+int32_t spm_log_str(const char *str, size_t len)
+{
+    if (!str || !len) {
+        return 0;
+    }
+    return log_record(LOG_REC_STR, str, len);
+}
+
+int32_t spm_log_msgval(const char *msg, size_t len, uint32_t value)
+{
+    struct log_ref_t ref = {msg, len, value};
+
+    if (log_record(LOG_REC_MSGVAL, &ref, sizeof(ref)) == 0) {
+        return 0;
+    }
+    return (int32_t)(len + MAX_DIGIT_BITS);
+}
+
+void spm_log_drain(void)
+{
+    uint32_t tail = log_tail;
+    uint32_t hdr, len, size, dropped;
+    struct log_ref_t ref;
+
+    while (tail != log_head) {
+        hdr = LOG_REC_HDR(tail);
+        if (!(hdr & LOG_REC_READY)) {
+            /* Still being written by a preempted context */
+            break;
+        }
+        __DMB();
+
+        len = hdr & LOG_REC_LEN_MASK;
+        size = LOG_REC_SIZE(len);
+
+        switch ((hdr & LOG_REC_TYPE_MASK) >> LOG_REC_TYPE_POS) {
+        case LOG_REC_STR:
+            log_buf_output(tail + sizeof(uint32_t), len);
+            break;
+        case LOG_REC_MSG:
+            log_buf_read(tail + sizeof(uint32_t), &ref, sizeof(ref));
+            tfm_hal_output_spm_log(ref.msg, ref.len);
+            break;
+        case LOG_REC_MSGVAL:
+            log_buf_read(tail + sizeof(uint32_t), &ref, sizeof(ref));
+            log_output_msgval(ref.msg, ref.len, ref.value);
+            break;
+        default:
+            break;
+        }
+
+        /* Clear the record before releasing its space */
+        for (; size > 0; size -= sizeof(uint32_t), tail += sizeof(uint32_t)) {
+            LOG_REC_HDR(tail) = 0;
+        }
+        __DMB();
+        log_tail = tail;
+    }
+
+    dropped = log_dropped;
+    if (dropped != log_dropped_reported) {
+        log_output_msgval("[SPM log] Records dropped: ",
+                          sizeof("[SPM log] Records dropped: "),
+                          dropped - log_dropped_reported);
+        log_dropped_reported = dropped;
+    }
+}
+
+#else /* TFM_SPM_LOG_BUFFERED */
+
+int32_t spm_log_msgval(const char *msg, size_t len, uint32_t value)
+{
+    return log_output_msgval(msg, len, value);
+}
+
+#endif /* TFM_SPM_LOG_BUFFERED */
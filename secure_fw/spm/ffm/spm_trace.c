@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "tfm_arch.h"
+#include "tfm_hal_platform.h"
+#include "tfm_spm_trace.h"
+
+/* Located by symbol name when the trace is read out */
+struct tfm_spm_trace_buf_t g_spm_trace = {
+    .magic = TFM_SPM_TRACE_MAGIC,
+    .version = TFM_SPM_TRACE_VERSION,
+    .entry_size = sizeof(struct tfm_spm_trace_entry_t),
+    .entry_num = TFM_SPM_TRACE_ENTRY_NUM,
+    .next_seq = 0,
+};
+
+void tfm_spm_trace_record(uint32_t event, uint32_t key, int32_t client_id)
+{
+    uint32_t seq;
+    volatile struct tfm_spm_trace_entry_t *entry;
+
+    /*
+     * Claim a slot first. A preempting recorder claims the next one, so
+     * entries are never shared; they only complete out of order.
+     */
+    seq = tfm_arch_fetch_add_u32(&g_spm_trace.next_seq, 1);
+    entry = &g_spm_trace.entries[seq & (TFM_SPM_TRACE_ENTRY_NUM - 1)];
+
+    /* Invalidate the slot while it is being written */
+    entry->info = 0;
+    entry->timestamp = tfm_hal_get_timestamp();
+    entry->key = key;
+    entry->client_id = client_id;
+    entry->info = (seq << TFM_SPM_TRACE_INFO_SEQ_POS) |
+                  (event & TFM_SPM_TRACE_INFO_EVT_MASK);
+}
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +10,7 @@
 #include "fih.h"
 #include "utilities.h"
 #include "tfm_hal_platform.h"
+#include "tfm_spm_log.h"
 
 void tfm_core_panic(void)
 {
@@ -21,6 +24,8 @@ void tfm_core_panic(void)
      * those error codes back to the calling task or to use its own
      * functionality for terminating an execution context.
      */
+    spm_log_drain();
+
     tfm_hal_system_reset();
 
 #ifdef TFM_FIH_PROFILE_ON
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +11,7 @@
 
 /* This header file collects the architecture related operations. */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <inttypes.h>
 #include "tfm_hal_device_header.h"
@@ -82,6 +85,57 @@ __STATIC_INLINE void __set_CONTROL_SPSEL(uint32_t SPSEL)
     __ISB();
 }
 
+/**
+ * \brief Atomically replace '*addr' with 'new_val' if it still holds
+ *        'old_val'.
+ *
+ * Exclusive access instructions are used where available. Armv6-M has no
+ * such instructions, the update is done with interrupts masked instead.
+ *
+ * \return true if the word is updated, false otherwise.
+ */
+__STATIC_INLINE bool tfm_arch_cas_u32(volatile uint32_t *addr,
+                                      uint32_t old_val, uint32_t new_val)
+{
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+    bool ret = false;
+
+    __disable_irq();
+    if (*addr == old_val) {
+        *addr = new_val;
+        ret = true;
+    }
+    __set_PRIMASK(primask);
+
+    return ret;
+#else
+    if (__LDREXW(addr) != old_val) {
+        __CLREX();
+        return false;
+    }
+
+    return __STREXW(new_val, addr) == 0;
+#endif
+}
+
+/**
+ * \brief Atomically add 'delta' to '*addr'.
+ *
+ * \return The value of '*addr' before the addition.
+ */
+__STATIC_INLINE uint32_t tfm_arch_fetch_add_u32(volatile uint32_t *addr,
+                                                uint32_t delta)
+{
+    uint32_t old_val;
+
+    do {
+        old_val = *addr;
+    } while (!tfm_arch_cas_u32(addr, old_val, old_val + delta));
+
+    return old_val;
+}
+
 /*
  * Initialize CPU architecture specific thread context extension
  */
@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -18,6 +20,8 @@ struct tfm_core_irq_signal_data_t {
     psa_signal_t signal_value;
     uint32_t irq_line;
     uint32_t irq_priority;
+    /* Assertion count of a coalesced IRQ, NULL if the IRQ is not coalesced */
+    volatile uint32_t *pending;
 };
 
 extern const struct tfm_core_irq_signal_data_t tfm_core_irq_signals[];
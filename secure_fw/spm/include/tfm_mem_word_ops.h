@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_MEM_WORD_OPS_H__
+#define __TFM_MEM_WORD_OPS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Word based memory copy and set, shared by the SPM utilities and the SPRT C
+ * runtime. They only do aligned word accesses, so they also work on cores
+ * without unaligned access support, such as Cortex-M0+.
+ */
+
+#define MEM_WORD_SIZE               sizeof(uint32_t)
+#define MEM_WORD_MASK               (MEM_WORD_SIZE - 1)
+#define MEM_WORD_BITS               32
+
+/* Number of words moved per iteration of the block loops */
+#define MEM_BLOCK_WORDS             4
+#define MEM_BLOCK_SIZE              (MEM_BLOCK_WORDS * MEM_WORD_SIZE)
+
+/* Copies shorter than this are done byte by byte */
+#define MEM_SMALL_COPY_SIZE         (2 * MEM_WORD_SIZE)
+
+/*
+ * Build the word which starts 'shift' bits into the aligned word 'lo' and
+ * continues in the following aligned word 'hi'. 'shift' is 8, 16 or 24.
+ */
+#ifdef __ARM_BIG_ENDIAN
+#define MEM_WORD_MERGE(lo, hi, shift)                                   \
+    (((lo) << (shift)) | ((hi) >> (MEM_WORD_BITS - (shift))))
+#else
+#define MEM_WORD_MERGE(lo, hi, shift)                                   \
+    (((lo) >> (shift)) | ((hi) << (MEM_WORD_BITS - (shift))))
+#endif
+
+union tfm_mem_addr_t {
+    uintptr_t uint_addr;        /* Address          */
+    uint8_t *p_byte;            /* Byte copy        */
+    uint32_t *p_qbyte;          /* Quad byte copy   */
+};
+
+/**
+ * \brief Copy memory from the lowest address upwards.
+ *
+ * \param[out] dest             Destination address.
+ * \param[in]  src              Source address.
+ * \param[in]  n                Number of bytes to copy.
+ *
+ * \return dest
+ *
+ * \note Overlapping buffers are only supported when dest is below src.
+ */
+static inline void *tfm_mem_copy_fwd(void *dest, const void *src, size_t n)
+{
+    union tfm_mem_addr_t p_dest, p_src;
+    uint32_t lo, hi, shift;
+
+    p_dest.uint_addr = (uintptr_t)dest;
+    p_src.uint_addr = (uintptr_t)src;
+
+    if (n >= MEM_SMALL_COPY_SIZE) {
+        /* Byte copy until the destination is word aligned. */
+        while (p_dest.uint_addr & MEM_WORD_MASK) {
+            *p_dest.p_byte++ = *p_src.p_byte++;
+            n--;
+        }
+
+        shift = (uint32_t)(p_src.uint_addr & MEM_WORD_MASK) * 8;
+        if (shift == 0) {
+            /* Both aligned: move a block of words per iteration. */
+            while (n >= MEM_BLOCK_SIZE) {
+                p_dest.p_qbyte[0] = p_src.p_qbyte[0];
+                p_dest.p_qbyte[1] = p_src.p_qbyte[1];
+                p_dest.p_qbyte[2] = p_src.p_qbyte[2];
+                p_dest.p_qbyte[3] = p_src.p_qbyte[3];
+                p_dest.p_qbyte += MEM_BLOCK_WORDS;
+                p_src.p_qbyte += MEM_BLOCK_WORDS;
+                n -= MEM_BLOCK_SIZE;
+            }
+
+            while (n >= MEM_WORD_SIZE) {
+                *p_dest.p_qbyte++ = *p_src.p_qbyte++;
+                n -= MEM_WORD_SIZE;
+            }
+        } else {
+            /*
+             * Source misaligned: read aligned source words and shift them
+             * into place. Every word read holds at least one byte being
+             * copied, so nothing outside the source buffer's words is read.
+             */
+            p_src.uint_addr &= ~(uintptr_t)MEM_WORD_MASK;
+            lo = *p_src.p_qbyte++;
+            while (n >= MEM_WORD_SIZE) {
+                hi = *p_src.p_qbyte++;
+                *p_dest.p_qbyte++ = MEM_WORD_MERGE(lo, hi, shift);
+                lo = hi;
+                n -= MEM_WORD_SIZE;
+            }
+            /* Step back to the first source byte not copied yet. */
+            p_src.uint_addr -= MEM_WORD_SIZE - shift / 8;
+        }
+    }
+
+    /* Byte copy for the remaining bytes. */
+    while (n--) {
+        *p_dest.p_byte++ = *p_src.p_byte++;
+    }
+
+    return dest;
+}
+
+/**
+ * \brief Copy memory from the highest address downwards.
+ *
+ * \param[out] dest             Destination address.
+ * \param[in]  src              Source address.
+ * \param[in]  n                Number of bytes to copy.
+ *
+ * \return dest
+ *
+ * \note Overlapping buffers are only supported when dest is above src.
+ */
+static inline void *tfm_mem_copy_bwd(void *dest, const void *src, size_t n)
+{
+    union tfm_mem_addr_t p_dest, p_src;
+    uint32_t lo, hi, shift;
+
+    p_dest.uint_addr = (uintptr_t)dest + n;
+    p_src.uint_addr = (uintptr_t)src + n;
+
+    if (n >= MEM_SMALL_COPY_SIZE) {
+        /* Byte copy until the end of destination is word aligned. */
+        while (p_dest.uint_addr & MEM_WORD_MASK) {
+            *(--p_dest.p_byte) = *(--p_src.p_byte);
+            n--;
+        }
+
+        shift = (uint32_t)(p_src.uint_addr & MEM_WORD_MASK) * 8;
+        if (shift == 0) {
+            /* Both aligned: move a block of words per iteration. */
+            while (n >= MEM_BLOCK_SIZE) {
+                p_dest.p_qbyte -= MEM_BLOCK_WORDS;
+                p_src.p_qbyte -= MEM_BLOCK_WORDS;
+                p_dest.p_qbyte[3] = p_src.p_qbyte[3];
+                p_dest.p_qbyte[2] = p_src.p_qbyte[2];
+                p_dest.p_qbyte[1] = p_src.p_qbyte[1];
+                p_dest.p_qbyte[0] = p_src.p_qbyte[0];
+                n -= MEM_BLOCK_SIZE;
+            }
+
+            while (n >= MEM_WORD_SIZE) {
+                *(--p_dest.p_qbyte) = *(--p_src.p_qbyte);
+                n -= MEM_WORD_SIZE;
+            }
+        } else {
+            /*
+             * Source misaligned: read aligned source words backwards and
+             * shift them into place, see tfm_mem_copy_fwd().
+             */
+            p_src.uint_addr &= ~(uintptr_t)MEM_WORD_MASK;
+            hi = *p_src.p_qbyte;
+            while (n >= MEM_WORD_SIZE) {
+                lo = *(--p_src.p_qbyte);
+                *(--p_dest.p_qbyte) = MEM_WORD_MERGE(lo, hi, shift);
+                hi = lo;
+                n -= MEM_WORD_SIZE;
+            }
+            /* Step forward to the end of the source bytes not copied yet. */
+            p_src.uint_addr += shift / 8;
+        }
+    }
+
+    /* Byte copy for the remaining bytes. */
+    while (n--) {
+        *(--p_dest.p_byte) = *(--p_src.p_byte);
+    }
+
+    return dest;
+}
+
+/**
+ * \brief Fill memory with a byte value.
+ *
+ * \param[out] s                Address of the memory to fill.
+ * \param[in]  c                Value to fill with, converted to uint8_t.
+ * \param[in]  n                Number of bytes to fill.
+ *
+ * \return s
+ */
+static inline void *tfm_mem_set(void *s, int c, size_t n)
+{
+    union tfm_mem_addr_t p_mem;
+    uint32_t quad_pattern;
+
+    p_mem.p_byte = (uint8_t *)s;
+    quad_pattern = (uint32_t)(uint8_t)c * 0x01010101U;
+
+    while (n && (p_mem.uint_addr & MEM_WORD_MASK)) {
+        *p_mem.p_byte++ = (uint8_t)c;
+        n--;
+    }
+
+    while (n >= MEM_BLOCK_SIZE) {
+        p_mem.p_qbyte[0] = quad_pattern;
+        p_mem.p_qbyte[1] = quad_pattern;
+        p_mem.p_qbyte[2] = quad_pattern;
+        p_mem.p_qbyte[3] = quad_pattern;
+        p_mem.p_qbyte += MEM_BLOCK_WORDS;
+        n -= MEM_BLOCK_SIZE;
+    }
+
+    while (n >= MEM_WORD_SIZE) {
+        *p_mem.p_qbyte++ = quad_pattern;
+        n -= MEM_WORD_SIZE;
+    }
+
+    while (n--) {
+        *p_mem.p_byte++ = (uint8_t)c;
+    }
+
+    return s;
+}
+
+#endif /* __TFM_MEM_WORD_OPS_H__ */
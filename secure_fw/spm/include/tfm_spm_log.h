@@ -1,5 +1,7 @@
 /*
  * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -36,7 +38,7 @@
 
 #if (TFM_SPM_LOG_LEVEL == TFM_SPM_LOG_LEVEL_DEBUG)
 #define SPMLOG_DBGMSGVAL(msg, val) spm_log_msgval(msg, sizeof(msg), val)
-#define SPMLOG_DBGMSG(msg) tfm_hal_output_spm_log(msg, sizeof(msg))
+#define SPMLOG_DBGMSG(msg) spm_log_msg(msg, sizeof(msg))
 #else
 #define SPMLOG_DBGMSGVAL(msg, val)
 #define SPMLOG_DBGMSG(msg)
@@ -44,7 +46,7 @@
 
 #if (TFM_SPM_LOG_LEVEL >= TFM_SPM_LOG_LEVEL_INFO)
 #define SPMLOG_INFMSGVAL(msg, val) spm_log_msgval(msg, sizeof(msg), val)
-#define SPMLOG_INFMSG(msg) tfm_hal_output_spm_log(msg, sizeof(msg))
+#define SPMLOG_INFMSG(msg) spm_log_msg(msg, sizeof(msg))
 #else
 #define SPMLOG_INFMSGVAL(msg, val)
 #define SPMLOG_INFMSG(msg)
@@ -52,12 +54,52 @@
 
 #if (TFM_SPM_LOG_LEVEL >= TFM_SPM_LOG_LEVEL_ERROR)
 #define SPMLOG_ERRMSGVAL(msg, val) spm_log_msgval(msg, sizeof(msg), val)
-#define SPMLOG_ERRMSG(msg) tfm_hal_output_spm_log(msg, sizeof(msg))
+#define SPMLOG_ERRMSG(msg) spm_log_msg(msg, sizeof(msg))
 #else
 #define SPMLOG_ERRMSGVAL(msg, val)
 #define SPMLOG_ERRMSG(msg)
 #endif
 
+#if defined(TFM_SPM_LOG_BUFFERED) && \
+    (TFM_SPM_LOG_LEVEL > TFM_SPM_LOG_LEVEL_SILENCE)
+/**
+ * \brief SPM output API for a constant message. The message is recorded by
+ *        reference into the log buffer, and output by \ref spm_log_drain.
+ *
+ * \param[in]  msg    A string message, which must stay valid forever
+ * \param[in]  len    The length of the message
+ *
+ * \retval >=0        Number of chars recorded, 0 if the buffer is full.
+ * \retval <0         TFM HAL error code.
+ */
+int32_t spm_log_msg(const char *msg, size_t len);
+
+/**
+ * \brief SPM output API for a string in a buffer. The string is copied into
+ *        the log buffer, and output by \ref spm_log_drain.
+ *
+ * \param[in]  str    A string
+ * \param[in]  len    The length of the string
+ *
+ * \retval >=0        Number of chars recorded, 0 if the buffer is full.
+ * \retval <0         TFM HAL error code.
+ */
+int32_t spm_log_str(const char *str, size_t len);
+
+/**
+ * \brief Output the log records in the log buffer through the HAL API
+ *        tfm_hal_output_spm_log, and report dropped records if any.
+ *
+ * \note This function is called on idle and before a reset. It stops at a
+ *       record which is still being written by a preempted caller.
+ */
+void spm_log_drain(void);
+#else
+#define spm_log_msg(msg, len)   tfm_hal_output_spm_log(msg, len)
+#define spm_log_str(str, len)   tfm_hal_output_spm_log(str, len)
+#define spm_log_drain()
+#endif
+
 /**
  * \brief SPM output API to convert digit number into HEX string and call the
  *        HAL API tfm_hal_output_spm_log.
@@ -68,6 +110,9 @@
  *
  * \retval >=0        Number of chars output.
  * \retval <0         TFM HAL error code.
+ *
+ * \note With TFM_SPM_LOG_BUFFERED, the message is recorded by reference with
+ *       the value, and both are output by \ref spm_log_drain.
  */
 int32_t spm_log_msgval(const char *msg, size_t len, uint32_t value);
 
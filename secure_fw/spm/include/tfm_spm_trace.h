@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SPM_TRACE_H__
+#define __TFM_SPM_TRACE_H__
+
+#include <stdint.h>
+
+/*
+ * SPM IPC trace. Events are recorded into a ring buffer in SPM memory, which
+ * is read out with a debugger and decoded by tools/spm_trace_decode.py.
+ * Keep the layout below in sync with the decoder.
+ */
+
+/* Number of entries in the ring buffer, must be a power of two */
+#ifndef TFM_SPM_TRACE_ENTRY_NUM
+#define TFM_SPM_TRACE_ENTRY_NUM         256
+#endif
+
+#if (TFM_SPM_TRACE_ENTRY_NUM & (TFM_SPM_TRACE_ENTRY_NUM - 1)) != 0
+#error "TFM_SPM_TRACE_ENTRY_NUM must be a power of two!"
+#endif
+
+#define TFM_SPM_TRACE_MAGIC             0x45435254 /* "TRCE" */
+#define TFM_SPM_TRACE_VERSION           1
+
+/* Trace events */
+#define TFM_SPM_TRACE_EVT_CONNECT       1 /* Client message sent: connect    */
+#define TFM_SPM_TRACE_EVT_CALL          2 /* Client message sent: request    */
+#define TFM_SPM_TRACE_EVT_CLOSE         3 /* Client message sent: disconnect */
+#define TFM_SPM_TRACE_EVT_GET           4 /* Service got the message         */
+#define TFM_SPM_TRACE_EVT_REPLY         5 /* Service replied to the message  */
+#define TFM_SPM_TRACE_EVT_SWITCH        6 /* Scheduler switched partitions   */
+#define TFM_SPM_TRACE_EVT_IRQ_SIGNAL    7 /* IRQ signal asserted             */
+
+/* Position of the fields in 'info' of a trace entry */
+#define TFM_SPM_TRACE_INFO_EVT_MASK     0xFFUL
+#define TFM_SPM_TRACE_INFO_SEQ_POS      8
+
+/*
+ * A trace entry. 'key' and 'client_id' depend on the event:
+ *  - message events: the SID and the client ID of the message;
+ *  - SWITCH: the partition IDs switched from and to;
+ *  - IRQ_SIGNAL: the partition ID and the IRQ line.
+ * 'info' holds the event and the low bits of the entry sequence number. It is
+ * written last, so a reader can tell whether the entry is complete.
+ */
+struct tfm_spm_trace_entry_t {
+    uint32_t timestamp;                 /* From tfm_hal_get_timestamp()   */
+    uint32_t key;                       /* SID or partition ID            */
+    int32_t client_id;                  /* Client ID, partition ID or IRQ */
+    uint32_t info;                      /* Sequence number and event      */
+};
+
+struct tfm_spm_trace_buf_t {
+    uint32_t magic;                     /* TFM_SPM_TRACE_MAGIC            */
+    uint16_t version;                   /* TFM_SPM_TRACE_VERSION          */
+    uint16_t entry_size;                /* Size of an entry in bytes      */
+    uint32_t entry_num;                 /* Number of entries              */
+    volatile uint32_t next_seq;         /* Sequence number of next entry  */
+    struct tfm_spm_trace_entry_t entries[TFM_SPM_TRACE_ENTRY_NUM];
+};
+
+#ifdef TFM_SPM_TRACE
+
+/**
+ * \brief Record a trace event.
+ *
+ * \param[in] event             One of TFM_SPM_TRACE_EVT_*.
+ * \param[in] key               SID or partition ID, see
+ *                              \ref tfm_spm_trace_entry_t.
+ * \param[in] client_id         Client ID, partition ID or IRQ line, see
+ *                              \ref tfm_spm_trace_entry_t.
+ *
+ * \note This function can be called from any handler, including interrupt
+ *       handlers preempting another call of it.
+ */
+void tfm_spm_trace_record(uint32_t event, uint32_t key, int32_t client_id);
+
+#define SPM_TRACE(event, key, client_id)                                 \
+    tfm_spm_trace_record((event), (uint32_t)(key), (int32_t)(client_id))
+
+#else /* TFM_SPM_TRACE */
+
+#define SPM_TRACE(event, key, client_id)
+
+#endif /* TFM_SPM_TRACE */
+
+#endif /* __TFM_SPM_TRACE_H__ */
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+/* Host replacement of the CMSIS compiler abstraction used by the Crypto code */
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE             static inline
+#endif
+
+#endif /* __CMSIS_COMPILER_H__ */
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_CRYPTO_HOST_H__
+#define __TFM_CRYPTO_HOST_H__
+
+/*
+ * Included ahead of each source. Mbed Crypto is not built on the host, so the
+ * PSA Crypto types come from interface/include and the key ID with owner of
+ * Mbed Crypto is a plain key ID.
+ */
+
+#include "tfm_mbedcrypto_include.h"
+
+typedef psa_key_id_t mbedtls_svc_key_id_t;
+
+#endif /* __TFM_CRYPTO_HOST_H__ */
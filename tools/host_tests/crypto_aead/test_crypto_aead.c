@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Regression test of the multi-part AEAD dispatch of the Crypto partition,
+ * built without TFM_CRYPTO_AEAD_MULTIPART_ENABLED as by default. Each
+ * multi-part AEAD function must sit at its SID in the dispatch table and
+ * return PSA_ERROR_NOT_SUPPORTED without touching its outputs or allocating
+ * an operation context.
+ *
+ * Usage: test_crypto_aead
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+
+#ifdef TFM_CRYPTO_AEAD_MULTIPART_ENABLED
+#error "This test checks the build without multi-part AEAD"
+#endif
+
+/* Marks an output which must be left untouched */
+#define UNTOUCHED                   0xA5
+
+/* Names of the functions in the dispatch table, as crypto_init.c builds it */
+static const char *const sfid_names[] = {
+#define X(api_name) #api_name,
+LIST_TFM_CRYPTO_UNIFORM_SIGNATURE_API
+#undef X
+};
+
+struct aead_multipart_t {
+    uint32_t        sid;
+    const char      *name;
+    tfm_crypto_us_t fn;
+};
+
+#define AEAD_MULTIPART(sid, fn)     { sid, #fn, fn }
+
+static const struct aead_multipart_t aead_multipart[] = {
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_ENCRYPT_SETUP_SID,
+                   tfm_crypto_aead_encrypt_setup),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_DECRYPT_SETUP_SID,
+                   tfm_crypto_aead_decrypt_setup),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_GENERATE_NONCE_SID,
+                   tfm_crypto_aead_generate_nonce),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_SET_NONCE_SID,
+                   tfm_crypto_aead_set_nonce),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_SET_LENGTHS_SID,
+                   tfm_crypto_aead_set_lengths),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_UPDATE_AD_SID,
+                   tfm_crypto_aead_update_ad),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_UPDATE_SID,
+                   tfm_crypto_aead_update),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_FINISH_SID,
+                   tfm_crypto_aead_finish),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_VERIFY_SID,
+                   tfm_crypto_aead_verify),
+    AEAD_MULTIPART(TFM_CRYPTO_AEAD_ABORT_SID,
+                   tfm_crypto_aead_abort),
+};
+
+#define ARRAY_LEN(a)                (sizeof(a) / sizeof((a)[0]))
+
+/* Number of calls into the Crypto services this test replaces */
+static uint32_t backend_calls;
+
+/*********************** Replacements of other modules ************************/
+
+psa_status_t tfm_crypto_get_caller_id(int32_t *id)
+{
+    *id = 1;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_check_handle_owner(psa_key_id_t key,
+                                           uint32_t *index)
+{
+    (void)key;
+    (void)index;
+
+    backend_calls++;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_encode_id_and_owner(psa_key_id_t key_id,
+                                            mbedtls_svc_key_id_t *enc_key_ptr)
+{
+    backend_calls++;
+    *enc_key_ptr = key_id;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_aead_encrypt(mbedtls_svc_key_id_t key,
+                              psa_algorithm_t alg,
+                              const uint8_t *nonce,
+                              size_t nonce_length,
+                              const uint8_t *additional_data,
+                              size_t additional_data_length,
+                              const uint8_t *plaintext,
+                              size_t plaintext_length,
+                              uint8_t *ciphertext,
+                              size_t ciphertext_size,
+                              size_t *ciphertext_length)
+{
+    backend_calls++;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_aead_decrypt(mbedtls_svc_key_id_t key,
+                              psa_algorithm_t alg,
+                              const uint8_t *nonce,
+                              size_t nonce_length,
+                              const uint8_t *additional_data,
+                              size_t additional_data_length,
+                              const uint8_t *ciphertext,
+                              size_t ciphertext_length,
+                              uint8_t *plaintext,
+                              size_t plaintext_size,
+                              size_t *plaintext_length)
+{
+    backend_calls++;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+/********************************** Tests *************************************/
+
+static int test_dispatch_table(void)
+{
+    uint32_t i, sid;
+
+    if (ARRAY_LEN(sfid_names) != TFM_CRYPTO_SID_MAX) {
+        printf("FAIL: %u functions in the dispatch table, %u SIDs\n",
+               (unsigned)ARRAY_LEN(sfid_names), (unsigned)TFM_CRYPTO_SID_MAX);
+        return 1;
+    }
+
+    for (i = 0; i < ARRAY_LEN(aead_multipart); i++) {
+        sid = aead_multipart[i].sid;
+        if (strcmp(sfid_names[sid], aead_multipart[i].name) != 0) {
+            printf("FAIL: SID %u dispatches to %s instead of %s\n",
+                   (unsigned)sid, sfid_names[sid], aead_multipart[i].name);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Call a function as the IPC handler does, with the vectors it accepts */
+static int test_not_supported(const struct aead_multipart_t *t)
+{
+    struct tfm_crypto_pack_iovec iov;
+    uint8_t data[16];
+    uint8_t out_data[16];
+    uint32_t handle_out;
+    psa_invec in_vec[2];
+    psa_outvec out_vec[2];
+    uint8_t expected[sizeof(out_data)];
+    psa_status_t status;
+
+    memset(&iov, 0, sizeof(iov));
+    iov.sfn_id = t->sid;
+    iov.key_id = 1;
+    iov.alg = PSA_ALG_GCM;
+    iov.op_handle = TFM_CRYPTO_INVALID_HANDLE;
+    memset(data, 0, sizeof(data));
+    memset(out_data, UNTOUCHED, sizeof(out_data));
+    memset(expected, UNTOUCHED, sizeof(expected));
+    memset(&handle_out, UNTOUCHED, sizeof(handle_out));
+
+    in_vec[0].base = &iov;
+    in_vec[0].len = sizeof(iov);
+    in_vec[1].base = data;
+    in_vec[1].len = sizeof(data);
+    out_vec[0].base = &handle_out;
+    out_vec[0].len = sizeof(handle_out);
+    out_vec[1].base = out_data;
+    out_vec[1].len = sizeof(out_data);
+
+    status = t->fn(in_vec, 2, out_vec, 2);
+
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        printf("FAIL: %s returned %d\n", t->name, (int)status);
+        return 1;
+    }
+    if ((memcmp(&handle_out, expected, sizeof(handle_out)) != 0) ||
+        (memcmp(out_data, expected, sizeof(out_data)) != 0) ||
+        (out_vec[0].len != sizeof(handle_out)) ||
+        (out_vec[1].len != sizeof(out_data))) {
+        printf("FAIL: %s wrote its outputs\n", t->name);
+        return 1;
+    }
+    if (backend_calls) {
+        printf("FAIL: %s called the backend\n", t->name);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* No call may leak an operation context */
+static int test_no_context_leak(void)
+{
+    uint32_t handles[TFM_CRYPTO_CONC_OPER_NUM];
+    void *ctx;
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_CONC_OPER_NUM; i++) {
+        handles[i] = TFM_CRYPTO_INVALID_HANDLE;
+        if (tfm_crypto_operation_alloc(TFM_CRYPTO_AEAD_OPERATION,
+                                       &handles[i], &ctx) != PSA_SUCCESS) {
+            printf("FAIL: operation context %u is in use\n", (unsigned)i);
+            return 1;
+        }
+    }
+
+    for (i = 0; i < TFM_CRYPTO_CONC_OPER_NUM; i++) {
+        if (tfm_crypto_operation_release(&handles[i]) != PSA_SUCCESS) {
+            printf("FAIL: operation context %u release\n", (unsigned)i);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    (void)tfm_crypto_init_alloc();
+
+    if (test_dispatch_table()) {
+        goto fail;
+    }
+
+    for (i = 0; i < ARRAY_LEN(aead_multipart); i++) {
+        if (test_not_supported(&aead_multipart[i])) {
+            goto fail;
+        }
+    }
+
+    if (test_no_context_leak()) {
+        goto fail;
+    }
+
+    printf("crypto_aead: %u multi-part functions passed\n",
+           (unsigned)ARRAY_LEN(aead_multipart));
+    return 0;
+
+fail:
+    printf("crypto_aead: FAILED\n");
+    return 1;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+/*
+ * Host replacement of the CMSIS compiler abstraction. Each core is a host
+ * thread. Masking the NSPE interrupts takes the lock which the simulated NSPE
+ * mailbox IRQ handler runs under.
+ */
+
+#include <stdint.h>
+
+#ifndef __INLINE
+#define __INLINE                    inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE             static inline
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#endif
+
+void host_ns_irq_disable(void);
+void host_ns_irq_enable(void);
+
+__STATIC_INLINE void __disable_irq(void)
+{
+    host_ns_irq_disable();
+}
+
+__STATIC_INLINE void __enable_irq(void)
+{
+    host_ns_irq_enable();
+}
+
+#define __DSB()                     __sync_synchronize()
+#define __DMB()                     __sync_synchronize()
+#define __ISB()                     __sync_synchronize()
+
+#endif /* __CMSIS_COMPILER_H__ */
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Platform HAL, NS OS wrapper and TF-M RPC replacements of the mailbox stress
+ * test. The SPE services stand in for SPM: an immediate call is replied while
+ * the mailbox handler runs, a deferred one is delivered and replied later.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "host_mailbox.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_ns_mailbox.h"
+#include "tfm_rpc.h"
+#include "tfm_spe_mailbox.h"
+
+struct host_doorbell_t host_spe_doorbell;
+struct host_doorbell_t host_ns_doorbell;
+
+struct host_mailbox_stats_t host_mailbox_stats;
+
+#define HOST_STATS_INC(field)   \
+    __atomic_fetch_add(&host_mailbox_stats.field, 1, __ATOMIC_RELAXED)
+
+/* Masked NSPE interrupts exclude the NSPE mailbox IRQ handler */
+static pthread_mutex_t ns_irq_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The NSPE mailbox queue passed from NSPE to SPE at initialization */
+static struct ns_mailbox_queue_t *ns_queue_ptr;
+
+/* NS OS lock, counting the calls in flight */
+static sem_t ns_os_lock;
+
+static __thread struct host_task_t *cur_task;
+
+/* Calls delivered to a service and not replied yet */
+struct host_deferred_t {
+    const void *owner;
+    int32_t    reply;
+};
+
+static const struct tfm_rpc_ops_t *rpc_ops;
+static struct host_deferred_t deferred[NUM_MAILBOX_QUEUE_SLOT];
+static uint32_t nr_deferred;
+static uint32_t spe_rng_state;
+
+/* xorshift32, private to the SPE core */
+static uint32_t spe_rng(void)
+{
+    spe_rng_state ^= spe_rng_state << 13;
+    spe_rng_state ^= spe_rng_state >> 17;
+    spe_rng_state ^= spe_rng_state << 5;
+
+    return spe_rng_state;
+}
+
+/******************************** Doorbells ***********************************/
+
+void host_doorbell_init(struct host_doorbell_t *db)
+{
+    pthread_mutex_init(&db->lock, NULL);
+    pthread_cond_init(&db->cond, NULL);
+    db->pending = false;
+    db->stop = false;
+}
+
+void host_doorbell_ring(struct host_doorbell_t *db)
+{
+    pthread_mutex_lock(&db->lock);
+    db->pending = true;
+    pthread_cond_signal(&db->cond);
+    pthread_mutex_unlock(&db->lock);
+}
+
+void host_doorbell_stop(struct host_doorbell_t *db)
+{
+    pthread_mutex_lock(&db->lock);
+    db->stop = true;
+    pthread_cond_signal(&db->cond);
+    pthread_mutex_unlock(&db->lock);
+}
+
+bool host_doorbell_wait(struct host_doorbell_t *db)
+{
+    bool is_running;
+
+    pthread_mutex_lock(&db->lock);
+    while (!db->pending && !db->stop) {
+        pthread_cond_wait(&db->cond, &db->lock);
+    }
+    db->pending = false;
+    is_running = !db->stop;
+    pthread_mutex_unlock(&db->lock);
+
+    return is_running;
+}
+
+/*********************************** NSPE *************************************/
+
+void host_ns_irq_disable(void)
+{
+    pthread_mutex_lock(&ns_irq_lock);
+}
+
+void host_ns_irq_enable(void)
+{
+    pthread_mutex_unlock(&ns_irq_lock);
+}
+
+void host_ns_mailbox_irq(void)
+{
+    host_ns_irq_disable();
+    (void)tfm_ns_mailbox_wake_reply_owner_isr();
+    host_ns_irq_enable();
+}
+
+void host_task_init(struct host_task_t *task)
+{
+    sem_init(&task->wake, 0, 0);
+    cur_task = task;
+}
+
+int32_t tfm_ns_mailbox_hal_init(struct ns_mailbox_queue_t *queue)
+{
+    ns_queue_ptr = queue;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_hal_notify_peer(void)
+{
+    HOST_STATS_INC(ns_notify);
+    host_doorbell_ring(&host_spe_doorbell);
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_lock_init(void)
+{
+    if (sem_init(&ns_os_lock, 0, NUM_MAILBOX_QUEUE_SLOT) != 0) {
+        return MAILBOX_GENERIC_ERROR;
+    }
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_lock_acquire(void)
+{
+    while (sem_wait(&ns_os_lock) != 0) {
+    }
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_lock_try_acquire(void)
+{
+    return (sem_trywait(&ns_os_lock) == 0) ? MAILBOX_SUCCESS :
+                                             MAILBOX_GENERIC_ERROR;
+}
+
+int32_t tfm_ns_mailbox_os_lock_release(void)
+{
+    return (sem_post(&ns_os_lock) == 0) ? MAILBOX_SUCCESS :
+                                          MAILBOX_GENERIC_ERROR;
+}
+
+const void *tfm_ns_mailbox_os_get_task_handle(void)
+{
+    return cur_task;
+}
+
+void tfm_ns_mailbox_os_wait_reply(void)
+{
+    while (sem_wait(&cur_task->wake) != 0) {
+    }
+}
+
+void tfm_ns_mailbox_os_wake_task_isr(const void *task_handle)
+{
+    struct host_task_t *task = (struct host_task_t *)task_handle;
+
+    if (task) {
+        sem_post(&task->wake);
+    }
+}
+
+/*********************************** SPE **************************************/
+
+int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue)
+{
+    s_queue->ns_queue = ns_queue_ptr;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_mailbox_hal_notify_peer(void)
+{
+    HOST_STATS_INC(spe_notify);
+    host_doorbell_ring(&host_ns_doorbell);
+
+    return MAILBOX_SUCCESS;
+}
+
+void tfm_arch_trigger_pendsv(void)
+{
+    HOST_STATS_INC(pendsv);
+    host_doorbell_ring(&host_spe_doorbell);
+}
+
+enum tfm_hal_status_t tfm_hal_memory_has_access(uintptr_t base,
+                                                size_t size,
+                                                uint32_t attr)
+{
+    (void)base;
+    (void)size;
+    (void)attr;
+
+    return TFM_HAL_SUCCESS;
+}
+
+int32_t tfm_rpc_register_ops(const struct tfm_rpc_ops_t *ops_ptr)
+{
+    if (!ops_ptr) {
+        return TFM_RPC_INVAL_PARAM;
+    }
+
+    rpc_ops = ops_ptr;
+
+    return TFM_RPC_SUCCESS;
+}
+
+void tfm_rpc_unregister_ops(void)
+{
+    rpc_ops = NULL;
+}
+
+uint32_t tfm_rpc_psa_framework_version(void)
+{
+    HOST_STATS_INC(dispatch);
+
+    return PSA_FRAMEWORK_VERSION;
+}
+
+uint32_t tfm_rpc_psa_version(const struct client_call_params_t *params,
+                             bool ns_caller)
+{
+    (void)params;
+    (void)ns_caller;
+
+    HOST_STATS_INC(dispatch);
+
+    return PSA_VERSION_NONE;
+}
+
+psa_status_t tfm_rpc_psa_connect(const struct client_call_params_t *params,
+                                 bool ns_caller)
+{
+    (void)params;
+    (void)ns_caller;
+
+    HOST_STATS_INC(dispatch);
+
+    return PSA_ERROR_CONNECTION_REFUSED;
+}
+
+psa_status_t tfm_rpc_psa_call(const struct client_call_params_t *params,
+                              bool ns_caller)
+{
+    (void)ns_caller;
+
+    HOST_STATS_INC(dispatch);
+
+    if ((params->type != HOST_CALL_DEFERRED) ||
+        (nr_deferred >= NUM_MAILBOX_QUEUE_SLOT)) {
+        return HOST_CALL_REPLY(params->handle);
+    }
+
+    /* As SPM does when it queues a message to a partition */
+    deferred[nr_deferred].owner = rpc_ops->get_caller_data(0);
+    deferred[nr_deferred].reply = HOST_CALL_REPLY(params->handle);
+    nr_deferred++;
+    HOST_STATS_INC(deferred);
+
+    return PSA_SUCCESS;
+}
+
+void tfm_rpc_psa_close(const struct client_call_params_t *params,
+                       bool ns_caller)
+{
+    (void)params;
+    (void)ns_caller;
+
+    HOST_STATS_INC(dispatch);
+}
+
+void host_spe_service_init(uint32_t seed)
+{
+    nr_deferred = 0;
+    spe_rng_state = seed ? seed : 1;
+}
+
+uint32_t host_spe_service_complete(bool all)
+{
+    struct host_deferred_t call;
+    uint32_t i, n;
+
+    n = all ? nr_deferred : (spe_rng() % (nr_deferred + 1));
+
+    while (n--) {
+        i = spe_rng() % nr_deferred;
+        call = deferred[i];
+        deferred[i] = deferred[--nr_deferred];
+
+        rpc_ops->reply(call.owner, call.reply);
+    }
+
+    return nr_deferred;
+}
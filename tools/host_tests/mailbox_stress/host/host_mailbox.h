@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __HOST_MAILBOX_H__
+#define __HOST_MAILBOX_H__
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Host simulation of a dual-core platform for the NSPE and SPE mailboxes.
+ * Each core is a set of host threads, the inter-core interrupts are doorbells.
+ */
+
+/* Types of the simulated psa_call(). The handle carries a cookie. */
+#define HOST_CALL_IMMEDIATE         1   /* Replied in the mailbox handler  */
+#define HOST_CALL_DEFERRED          2   /* Replied later, in random order  */
+
+/* The result of a simulated psa_call() */
+#define HOST_CALL_REPLY(cookie)     ((int32_t)((uint32_t)(cookie) ^ 0x5A5A5A5AUL))
+
+/* An inter-core interrupt. Rings while pending are merged into one. */
+struct host_doorbell_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    bool            pending;
+    bool            stop;
+};
+
+/* Raised by NSPE and by SPE PendSV, taken by the SPE core */
+extern struct host_doorbell_t host_spe_doorbell;
+/* Raised by SPE, taken by the NSPE mailbox IRQ handler */
+extern struct host_doorbell_t host_ns_doorbell;
+
+void host_doorbell_init(struct host_doorbell_t *db);
+void host_doorbell_ring(struct host_doorbell_t *db);
+void host_doorbell_stop(struct host_doorbell_t *db);
+
+/* Wait for and clear the doorbell. Return false once it is stopped. */
+bool host_doorbell_wait(struct host_doorbell_t *db);
+
+struct host_mailbox_stats_t {
+    uint32_t ns_notify;             /* Doorbells rung by NSPE            */
+    uint32_t spe_notify;            /* Doorbells rung by SPE             */
+    uint32_t pendsv;                /* SPE handler runs deferred by SPE  */
+    uint32_t dispatch;              /* Messages dispatched to services   */
+    uint32_t deferred;              /* Messages delivered to a service   */
+};
+
+extern struct host_mailbox_stats_t host_mailbox_stats;
+
+/* A non-secure task, as seen by the NS OS wrapper of the NSPE mailbox */
+struct host_task_t {
+    sem_t wake;
+};
+
+/* Bind a task to the calling thread */
+void host_task_init(struct host_task_t *task);
+
+/* Run the NSPE mailbox IRQ handler, as the doorbell interrupt would */
+void host_ns_mailbox_irq(void);
+
+/* Reset the simulated services. Call before SPE mailbox initialization. */
+void host_spe_service_init(uint32_t seed);
+
+/*
+ * Reply a random subset of the deferred calls, all of them if 'all' is set,
+ * in random order. Run on the SPE core. Return the number still deferred.
+ */
+uint32_t host_spe_service_complete(bool all);
+
+#endif /* __HOST_MAILBOX_H__ */
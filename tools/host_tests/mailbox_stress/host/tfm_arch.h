@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_ARCH_H__
+#define __TFM_ARCH_H__
+
+/*
+ * Host replacement of the architecture layer, reduced to what the SPE mailbox
+ * uses. PendSV runs the SPE mailbox handler again, see host_mailbox.c.
+ */
+
+void tfm_arch_trigger_pendsv(void);
+
+#endif /* __TFM_ARCH_H__ */
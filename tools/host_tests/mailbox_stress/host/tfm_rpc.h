@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_RPC_H__
+#define __TFM_RPC_H__
+
+/*
+ * Host replacement of the TF-M RPC interface, without SPM. It is included
+ * ahead of secure_fw/spm/cmsis_psa/tfm_rpc.h, which takes the same guard.
+ * The simulated services are in host_mailbox.c.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+
+#define TFM_RPC_SUCCESS             (0)
+#define TFM_RPC_INVAL_PARAM         (INT32_MIN + 1)
+#define TFM_RPC_CONFLICT_CALLBACK   (INT32_MIN + 2)
+
+struct client_call_params_t {
+    uint32_t        sid;
+    psa_handle_t    handle;
+    int32_t         type;
+    const psa_invec *in_vec;
+    size_t          in_len;
+    psa_outvec      *out_vec;
+    size_t          out_len;
+    uint32_t        version;
+};
+
+struct tfm_rpc_ops_t {
+    void (*handle_req)(void);
+    void (*reply)(const void *owner, int32_t ret);
+    const void * (*get_caller_data)(int32_t client_id);
+};
+
+uint32_t tfm_rpc_psa_framework_version(void);
+
+uint32_t tfm_rpc_psa_version(const struct client_call_params_t *params,
+                             bool ns_caller);
+
+psa_status_t tfm_rpc_psa_connect(const struct client_call_params_t *params,
+                                 bool ns_caller);
+
+psa_status_t tfm_rpc_psa_call(const struct client_call_params_t *params,
+                              bool ns_caller);
+
+void tfm_rpc_psa_close(const struct client_call_params_t *params,
+                       bool ns_caller);
+
+int32_t tfm_rpc_register_ops(const struct tfm_rpc_ops_t *ops_ptr);
+
+void tfm_rpc_unregister_ops(void);
+
+#endif /* __TFM_RPC_H__ */
@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Stress test of the NSPE and SPE mailboxes on a simulated dual-core host.
+ * The mailbox code is the target code. Each core is a set of host threads and
+ * the inter-core interrupts are doorbells, see host/host_mailbox.c.
+ *
+ * - corrupted ring: NSPE writes invalid request ring indices and entries. SPE
+ *   must reject them without handling any request twice.
+ * - stress: more NS tasks than slots make synchronous and asynchronous calls,
+ *   replied at once or later in random order. Every reply must reach its
+ *   caller. Throughput, latency and the spread between tasks are reported.
+ * - hostile NSPE: NSPE rewrites both rings while SPE handles them. Each run
+ *   of the SPE handler must return after at most one ring of requests.
+ *
+ * Usage: test_mailbox_stress [iterations] [seed]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_mailbox.h"
+#include "tfm_arch.h"
+#include "tfm_ns_mailbox.h"
+#include "tfm_spe_mailbox.h"
+
+#define NR_SLOTS                    NUM_MAILBOX_QUEUE_SLOT
+#define NR_TASKS                    (NUM_MAILBOX_QUEUE_SLOT + 2)
+
+/* Ways a stress task submits a call */
+enum {
+    CALL_SYNC,
+    CALL_ASYNC_WAIT,
+    CALL_ASYNC_CB,
+    CALL_VERSION,
+    CALL_KIND_NUM
+};
+
+struct stress_task_t {
+    pthread_t          thread;
+    struct host_task_t task;
+    sem_t              cb_done;     /* Posted by the completion callback */
+    int32_t            cb_reply;
+    uint32_t           id;
+    uint32_t           rng_state;
+    uint32_t           errors;
+    uint32_t           calls;
+    double             lat_sum_ns;
+    double             lat_max_ns;
+    double             end_ns;
+};
+
+static struct ns_mailbox_queue_t ns_queue __ALIGNED(MAILBOX_CACHE_LINE_SIZE);
+
+static uint32_t rng_state;
+static uint32_t iterations = 10000;
+static struct stress_task_t tasks[NR_TASKS];
+static pthread_t spe_thread;
+static pthread_t ns_irq_thread;
+static volatile int hostile_started;
+static volatile int hostile_stop;
+static uint32_t hostile_errors;
+
+/* xorshift32, so that a failure is reproducible from the seed */
+static uint32_t xorshift32(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+static uint32_t rng(void)
+{
+    return xorshift32(&rng_state);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int mailbox_setup(void)
+{
+    host_doorbell_init(&host_spe_doorbell);
+    host_doorbell_init(&host_ns_doorbell);
+    host_spe_service_init(rng());
+    memset(&host_mailbox_stats, 0, sizeof(host_mailbox_stats));
+
+    if (tfm_ns_mailbox_init(&ns_queue) != MAILBOX_SUCCESS) {
+        printf("FAIL: NSPE mailbox initialization\n");
+        return 1;
+    }
+    if (tfm_mailbox_init() != MAILBOX_SUCCESS) {
+        printf("FAIL: SPE mailbox initialization\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static void set_call_msg(struct mailbox_msg_t *msg, int32_t type,
+                         uint32_t cookie)
+{
+    memset(msg, 0, sizeof(*msg));
+    msg->call_type = MAILBOX_PSA_CALL;
+    msg->params.psa_call_params.handle = (psa_handle_t)cookie;
+    msg->params.psa_call_params.type = type;
+}
+
+/***************************** Corrupted ring *********************************/
+
+static int check_handle(const char *what, int32_t expected, uint32_t req_tail)
+{
+    int32_t ret = tfm_mailbox_handle_msg();
+
+    if (ret != expected) {
+        printf("FAIL: %s: handler returned %d, expected %d\n",
+               what, (int)ret, (int)expected);
+        return 1;
+    }
+    if (ns_queue.req_ring.tail.idx != req_tail) {
+        printf("FAIL: %s: request tail %u, expected %u\n", what,
+               (unsigned)ns_queue.req_ring.tail.idx, (unsigned)req_tail);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_corrupted_ring(void)
+{
+    struct mailbox_ring_t *req = &ns_queue.req_ring;
+    struct mailbox_ring_t *cpl = &ns_queue.cpl_ring;
+    uint32_t cookie = 0x1234;
+    uint8_t idx;
+
+    if (mailbox_setup()) {
+        return 1;
+    }
+
+    /* Heads out of [0, 2 * NUM_MAILBOX_QUEUE_SLOT) */
+    req->head.idx = 2 * NR_SLOTS;
+    if (check_handle("head 2N", MAILBOX_INVAL_PARAMS, 0)) {
+        return 1;
+    }
+    req->head.idx = UINT32_MAX;
+    if (check_handle("head UINT32_MAX", MAILBOX_INVAL_PARAMS, 0)) {
+        return 1;
+    }
+
+#if NUM_MAILBOX_QUEUE_SLOT > 1
+    /* A valid head, but more requests than slots */
+    req->head.idx = NR_SLOTS + 1;
+    if (check_handle("head N + 1", MAILBOX_INVAL_PARAMS, 0)) {
+        return 1;
+    }
+#endif
+
+    req->head.idx = 0;
+    if (check_handle("empty ring", MAILBOX_NO_PEND_EVENT, 0)) {
+        return 1;
+    }
+
+    /* An entry out of range is consumed and dropped */
+    req->entries[0] = NR_SLOTS;
+    req->head.idx = 1;
+    if (check_handle("invalid entry", MAILBOX_SUCCESS, 1)) {
+        return 1;
+    }
+    if (host_mailbox_stats.dispatch || !mailbox_ring_is_empty(cpl)) {
+        printf("FAIL: invalid entry was handled\n");
+        return 1;
+    }
+
+    /* A slot queued twice is only handled once while it is pending */
+    set_call_msg(&ns_queue.queue[0].msg, HOST_CALL_DEFERRED, cookie);
+    req->entries[1 % NR_SLOTS] = 0;
+    req->entries[2 % NR_SLOTS] = 0;
+    req->head.idx = mailbox_ring_next(mailbox_ring_next(1));
+    if (check_handle("duplicate entry", MAILBOX_SUCCESS, req->head.idx)) {
+        return 1;
+    }
+    if ((host_mailbox_stats.deferred != 1) || !mailbox_ring_is_empty(cpl)) {
+        printf("FAIL: duplicate entry: %u deferred, completion ring %s\n",
+               (unsigned)host_mailbox_stats.deferred,
+               mailbox_ring_is_empty(cpl) ? "empty" : "not empty");
+        return 1;
+    }
+
+    /* The slot is replied once */
+    (void)host_spe_service_complete(true);
+    if ((mailbox_ring_pop(cpl, &idx) != MAILBOX_SUCCESS) || (idx != 0) ||
+        !mailbox_ring_is_empty(cpl)) {
+        printf("FAIL: duplicate entry: wrong completion\n");
+        return 1;
+    }
+    if (ns_queue.queue[0].reply.return_val != HOST_CALL_REPLY(cookie)) {
+        printf("FAIL: duplicate entry: wrong reply\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/********************************* Stress *************************************/
+
+static void *spe_core_main(void *arg)
+{
+    (void)arg;
+
+    while (host_doorbell_wait(&host_spe_doorbell)) {
+        (void)tfm_mailbox_handle_msg();
+
+        /* Come back for the calls still deferred, as a partition would */
+        if (host_spe_service_complete(false)) {
+            tfm_arch_trigger_pendsv();
+        }
+    }
+
+    return NULL;
+}
+
+static void *ns_irq_main(void *arg)
+{
+    (void)arg;
+
+    while (host_doorbell_wait(&host_ns_doorbell)) {
+        host_ns_mailbox_irq();
+    }
+
+    return NULL;
+}
+
+static void stress_cb(void *arg, int32_t reply)
+{
+    struct stress_task_t *t = arg;
+
+    t->cb_reply = reply;
+    sem_post(&t->cb_done);
+}
+
+/* Submit one call and wait for its reply. Return the reply. */
+static int32_t stress_call(struct stress_task_t *t, uint32_t kind,
+                           const struct psa_client_params_t *params,
+                           uint32_t call_type)
+{
+    int32_t reply = 0;
+    uint32_t token;
+    int32_t ret;
+
+    switch (kind) {
+    case CALL_ASYNC_WAIT:
+        while ((ret = tfm_ns_mailbox_client_call_async(call_type, params,
+                                                       0, NULL, NULL,
+                                                       &token)) ==
+               MAILBOX_QUEUE_FULL) {
+            sched_yield();
+        }
+        if (ret == MAILBOX_SUCCESS) {
+            ret = tfm_ns_mailbox_client_wait(token, &reply);
+        }
+        break;
+    case CALL_ASYNC_CB:
+        while ((ret = tfm_ns_mailbox_client_call_async(call_type, params,
+                                                       0, stress_cb, t,
+                                                       NULL)) ==
+               MAILBOX_QUEUE_FULL) {
+            sched_yield();
+        }
+        if (ret == MAILBOX_SUCCESS) {
+            while (sem_wait(&t->cb_done) != 0) {
+            }
+            reply = t->cb_reply;
+        }
+        break;
+    default:
+        ret = tfm_ns_mailbox_client_call(call_type, params, 0, &reply);
+        break;
+    }
+
+    if (ret != MAILBOX_SUCCESS) {
+        t->errors++;
+    }
+
+    return reply;
+}
+
+static void *stress_task_main(void *arg)
+{
+    struct stress_task_t *t = arg;
+    struct psa_client_params_t params;
+    uint32_t i, kind, cookie;
+    int32_t reply, expected;
+    double start, lat;
+
+    host_task_init(&t->task);
+
+    for (i = 0; i < iterations; i++) {
+        kind = xorshift32(&t->rng_state) % CALL_KIND_NUM;
+        cookie = (t->id << 24) | (i & 0xFFFFFF);
+
+        memset(&params, 0, sizeof(params));
+        start = now_ns();
+
+        if (kind == CALL_VERSION) {
+            expected = PSA_FRAMEWORK_VERSION;
+            reply = stress_call(t, CALL_SYNC, &params,
+                                MAILBOX_PSA_FRAMEWORK_VERSION);
+        } else {
+            params.psa_call_params.handle = (psa_handle_t)cookie;
+            params.psa_call_params.type =
+                (xorshift32(&t->rng_state) & 1) ? HOST_CALL_DEFERRED :
+                                                  HOST_CALL_IMMEDIATE;
+            expected = HOST_CALL_REPLY(cookie);
+            reply = stress_call(t, kind, &params, MAILBOX_PSA_CALL);
+        }
+
+        lat = now_ns() - start;
+        t->lat_sum_ns += lat;
+        if (lat > t->lat_max_ns) {
+            t->lat_max_ns = lat;
+        }
+
+        if (reply != expected) {
+            printf("FAIL: task %u call %u kind %u: reply 0x%x, "
+                   "expected 0x%x\n", (unsigned)t->id, (unsigned)i,
+                   (unsigned)kind, (unsigned)reply, (unsigned)expected);
+            t->errors++;
+        }
+        t->calls++;
+    }
+
+    t->end_ns = now_ns();
+
+    return NULL;
+}
+
+static int test_stress(void)
+{
+    struct stress_task_t *t;
+    uint32_t i, calls = 0, errors = 0;
+    double start, lat_sum = 0, lat_max = 0, end_min = 0, end_max = 0;
+
+    if (mailbox_setup()) {
+        return 1;
+    }
+
+    pthread_create(&spe_thread, NULL, spe_core_main, NULL);
+    pthread_create(&ns_irq_thread, NULL, ns_irq_main, NULL);
+
+    start = now_ns();
+    for (i = 0; i < NR_TASKS; i++) {
+        t = &tasks[i];
+        memset(t, 0, sizeof(*t));
+        t->id = i;
+        t->rng_state = rng() | 1;
+        sem_init(&t->cb_done, 0, 0);
+        pthread_create(&t->thread, NULL, stress_task_main, t);
+    }
+
+    for (i = 0; i < NR_TASKS; i++) {
+        t = &tasks[i];
+        pthread_join(t->thread, NULL);
+
+        calls += t->calls;
+        errors += t->errors;
+        lat_sum += t->lat_sum_ns;
+        if (t->lat_max_ns > lat_max) {
+            lat_max = t->lat_max_ns;
+        }
+        if (!i || (t->end_ns < end_min)) {
+            end_min = t->end_ns;
+        }
+        if (!i || (t->end_ns > end_max)) {
+            end_max = t->end_ns;
+        }
+    }
+
+    host_doorbell_stop(&host_spe_doorbell);
+    host_doorbell_stop(&host_ns_doorbell);
+    pthread_join(spe_thread, NULL);
+    pthread_join(ns_irq_thread, NULL);
+
+    printf("stress: %u tasks, %u slots, %u calls, %.0f calls/s\n",
+           (unsigned)NR_TASKS, (unsigned)NR_SLOTS, (unsigned)calls,
+           calls / ((end_max - start) / 1e9));
+    printf("  latency avg %.1f us, max %.1f us\n",
+           lat_sum / calls / 1e3, lat_max / 1e3);
+    printf("  doorbells per call: to SPE %.2f, to NSPE %.2f, "
+           "SPE re-runs %.2f\n",
+           (double)host_mailbox_stats.ns_notify / calls,
+           (double)host_mailbox_stats.spe_notify / calls,
+           (double)host_mailbox_stats.pendsv / calls);
+    printf("  first and last task done at %.1f%% and 100%% of the run\n",
+           100.0 * (end_min - start) / (end_max - start));
+
+    if (!mailbox_ring_is_empty(&ns_queue.req_ring) ||
+        !mailbox_ring_is_empty(&ns_queue.cpl_ring)) {
+        printf("FAIL: rings not empty after the run\n");
+        errors++;
+    }
+
+    return errors ? 1 : 0;
+}
+
+/******************************* Hostile NSPE *********************************/
+
+static void *hostile_ns_main(void *arg)
+{
+    uint32_t state = *(uint32_t *)arg;
+    uint32_t r;
+
+    hostile_started = 1;
+
+    while (!hostile_stop) {
+        r = xorshift32(&state);
+
+        switch (r & 7) {
+        case 0:
+            ns_queue.req_ring.head.idx = xorshift32(&state);
+            break;
+        case 1:
+        case 2:
+            ns_queue.req_ring.head.idx = (r >> 8) % (2 * NR_SLOTS);
+            break;
+        case 3:
+            ns_queue.req_ring.entries[(r >> 8) % NR_SLOTS] =
+                                           (uint8_t)((r >> 16) % (NR_SLOTS + 2));
+            break;
+        case 4:
+            set_call_msg(&ns_queue.queue[(r >> 8) % NR_SLOTS].msg,
+                         (r & 0x10000) ? HOST_CALL_DEFERRED :
+                                         HOST_CALL_IMMEDIATE, r);
+            break;
+        case 5:
+            ns_queue.queue[(r >> 8) % NR_SLOTS].msg.call_type = (r >> 16) % 7;
+            break;
+        case 6:
+            ns_queue.cpl_ring.tail.idx = ns_queue.cpl_ring.head.idx;
+            break;
+        default:
+            ns_queue.cpl_ring.head.idx = xorshift32(&state);
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static int test_hostile(void)
+{
+    pthread_t hostile;
+    uint32_t hostile_seed;
+    uint32_t i, before, handled;
+    uint32_t max_handled = 0;
+
+    if (mailbox_setup()) {
+        return 1;
+    }
+
+    hostile_seed = rng() | 1;
+    hostile_started = 0;
+    hostile_stop = 0;
+    hostile_errors = 0;
+    pthread_create(&hostile, NULL, hostile_ns_main, &hostile_seed);
+    while (!hostile_started) {
+        sched_yield();
+    }
+
+    /* This thread is the SPE core */
+    for (i = 0; i < iterations; i++) {
+        before = host_mailbox_stats.dispatch;
+        (void)tfm_mailbox_handle_msg();
+        handled = host_mailbox_stats.dispatch - before;
+
+        if (handled > max_handled) {
+            max_handled = handled;
+        }
+        if (handled > NR_SLOTS) {
+            hostile_errors++;
+        }
+
+        (void)host_spe_service_complete(false);
+    }
+
+    hostile_stop = 1;
+    pthread_join(hostile, NULL);
+
+    printf("hostile: %u handler runs, at most %u requests per run\n",
+           (unsigned)iterations, (unsigned)max_handled);
+
+    if (hostile_errors) {
+        printf("FAIL: %u handler runs took more than %u requests\n",
+               (unsigned)hostile_errors, (unsigned)NR_SLOTS);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t seed = 1;
+
+    if (argc > 1) {
+        iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        seed = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    rng_state = seed ? seed : 1;
+
+    if (test_corrupted_ring() || test_stress() || test_hostile()) {
+        printf("mailbox_stress: FAILED, seed 0x%x\n", (unsigned)seed);
+        return 1;
+    }
+
+    printf("mailbox_stress: %u iterations passed\n", (unsigned)iterations);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Microbenchmark of the word based memory routines against a byte loop, which
+ * is what a misaligned copy did before, and the host C library. The host
+ * numbers only show the relative gain. Cycle counts on a target are measured
+ * with the same sizes and alignments.
+ *
+ * Usage: bench_mem_word_ops [bytes per measurement]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tfm_mem_word_ops.h"
+
+#define BUF_LEN                     (4096 + 2 * MEM_WORD_SIZE)
+
+static uint32_t buf_src[BUF_LEN / sizeof(uint32_t)];
+static uint32_t buf_dst[BUF_LEN / sizeof(uint32_t)];
+
+typedef void *(*copy_fn_t)(void *dest, const void *src, size_t n);
+
+static void *byte_copy(void *dest, const void *src, size_t n)
+{
+    volatile uint8_t *d = dest;
+    const volatile uint8_t *s = src;
+
+    while (n--) {
+        *d++ = *s++;
+    }
+
+    return dest;
+}
+
+static void *libc_copy(void *dest, const void *src, size_t n)
+{
+    return memcpy(dest, src, n);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench(copy_fn_t fn, size_t len, size_t dst_off, size_t src_off,
+                    size_t total)
+{
+    uint8_t *dst = (uint8_t *)buf_dst + dst_off;
+    uint8_t *src = (uint8_t *)buf_src + src_off;
+    size_t rounds = total / len + 1;
+    double start;
+    size_t i;
+
+    start = now_ns();
+    for (i = 0; i < rounds; i++) {
+        fn(dst, src, len);
+        /* Keep the copies from being merged or dropped */
+        __asm__ volatile("" : : "r"(dst) : "memory");
+    }
+
+    return (now_ns() - start) / (double)rounds;
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = {16, 64, 256, 1024, 4096};
+    static const size_t offs[][2] = {{0, 0}, {0, 1}, {1, 3}, {2, 0}};
+    size_t total = 64 * 1024 * 1024;
+    size_t i, j;
+
+    if (argc > 1) {
+        total = strtoul(argv[1], NULL, 0);
+    }
+
+    memset(buf_src, 0xA5, sizeof(buf_src));
+
+    printf("%6s %8s %12s %12s %12s\n",
+           "size", "dst/src", "byte ns", "word ns", "libc ns");
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (j = 0; j < sizeof(offs) / sizeof(offs[0]); j++) {
+            printf("%6zu %5zu/%zu %12.1f %12.1f %12.1f\n",
+                   sizes[i], offs[j][0], offs[j][1],
+                   bench(byte_copy, sizes[i], offs[j][0], offs[j][1], total),
+                   bench(tfm_mem_copy_fwd, sizes[i], offs[j][0], offs[j][1],
+                         total),
+                   bench(libc_copy, sizes[i], offs[j][0], offs[j][1], total));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Differential fuzz test of the word based memory routines shared by SPM and
+ * SPRT. Random sizes, alignments, fill values and overlaps are checked against
+ * the host C library. The bytes around the destination must stay untouched.
+ *
+ * Usage: test_mem_word_ops [iterations] [seed]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tfm_mem_word_ops.h"
+
+#define MAX_LEN                     300
+#define MAX_OFFSET                  (2 * MEM_WORD_SIZE)
+#define GUARD_LEN                   16
+#define BUF_LEN                     (GUARD_LEN + MAX_OFFSET + MAX_LEN + \
+                                     MAX_OFFSET + GUARD_LEN)
+
+static uint32_t rng_state;
+
+/* xorshift32, so that a failure is reproducible from the seed */
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+
+    return rng_state;
+}
+
+/* Word aligned, so that the offsets pick every source/destination alignment */
+static uint32_t buf_src[BUF_LEN / sizeof(uint32_t) + 1];
+static uint32_t buf_dst[BUF_LEN / sizeof(uint32_t) + 1];
+static uint8_t  buf_ref[BUF_LEN];
+
+static void fill_random(uint8_t *p, size_t len)
+{
+    while (len--) {
+        *p++ = (uint8_t)rng();
+    }
+}
+
+static int check(const char *what, uint32_t iter, size_t len,
+                 size_t dst_off, size_t src_off)
+{
+    if (memcmp(buf_dst, buf_ref, BUF_LEN) == 0) {
+        return 0;
+    }
+
+    printf("FAIL: %s iter %u len %zu dst offset %zu src offset %zu\n",
+           what, (unsigned)iter, len, dst_off, src_off);
+    return 1;
+}
+
+/* Copy between two distinct buffers */
+static int test_copy(uint32_t iter)
+{
+    uint8_t *src = (uint8_t *)buf_src;
+    uint8_t *dst = (uint8_t *)buf_dst;
+    size_t len = rng() % (MAX_LEN + 1);
+    size_t dst_off = GUARD_LEN + rng() % MAX_OFFSET;
+    size_t src_off = GUARD_LEN + rng() % MAX_OFFSET;
+    int err = 0;
+
+    fill_random(src, BUF_LEN);
+    fill_random(dst, BUF_LEN);
+    memcpy(buf_ref, dst, BUF_LEN);
+
+    memcpy(buf_ref + dst_off, src + src_off, len);
+    if (tfm_mem_copy_fwd(dst + dst_off, src + src_off, len) != dst + dst_off) {
+        printf("FAIL: copy_fwd return value\n");
+        err++;
+    }
+    err += check("copy_fwd", iter, len, dst_off, src_off);
+
+    memcpy(dst, buf_ref, BUF_LEN);
+    fill_random(src, BUF_LEN);
+    memcpy(buf_ref + dst_off, src + src_off, len);
+    if (tfm_mem_copy_bwd(dst + dst_off, src + src_off, len) != dst + dst_off) {
+        printf("FAIL: copy_bwd return value\n");
+        err++;
+    }
+    err += check("copy_bwd", iter, len, dst_off, src_off);
+
+    return err;
+}
+
+/* Overlapping move inside one buffer, dispatched as the SPRT memmove() does */
+static int test_move(uint32_t iter)
+{
+    uint8_t *dst = (uint8_t *)buf_dst;
+    size_t len = rng() % (MAX_LEN + 1);
+    size_t dst_off = GUARD_LEN + rng() % (2 * MAX_OFFSET);
+    size_t src_off = GUARD_LEN + rng() % (2 * MAX_OFFSET);
+
+    fill_random(dst, BUF_LEN);
+    memcpy(buf_ref, dst, BUF_LEN);
+
+    memmove(buf_ref + dst_off, buf_ref + src_off, len);
+    if (src_off >= dst_off) {
+        tfm_mem_copy_fwd(dst + dst_off, dst + src_off, len);
+    } else {
+        tfm_mem_copy_bwd(dst + dst_off, dst + src_off, len);
+    }
+
+    return check("move", iter, len, dst_off, src_off);
+}
+
+static int test_set(uint32_t iter)
+{
+    uint8_t *dst = (uint8_t *)buf_dst;
+    size_t len = rng() % (MAX_LEN + 1);
+    size_t dst_off = GUARD_LEN + rng() % MAX_OFFSET;
+    /* Out of range values must be truncated to a byte */
+    int c = (int)(rng() % 1024) - 512;
+
+    fill_random(dst, BUF_LEN);
+    memcpy(buf_ref, dst, BUF_LEN);
+
+    memset(buf_ref + dst_off, c, len);
+    if (tfm_mem_set(dst + dst_off, c, len) != dst + dst_off) {
+        printf("FAIL: set return value\n");
+        return 1;
+    }
+
+    return check("set", iter, len, dst_off, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = 100000;
+    uint32_t seed = 0x5EED1234;
+    uint32_t i;
+    int err = 0;
+
+    if (argc > 1) {
+        iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        seed = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    rng_state = seed ? seed : 1;
+
+    for (i = 0; (i < iterations) && (err == 0); i++) {
+        err += test_copy(i);
+        err += test_move(i);
+        err += test_set(i);
+    }
+
+    if (err) {
+        printf("mem_word_ops: FAILED, seed 0x%x\n", (unsigned)seed);
+        return 1;
+    }
+
+    printf("mem_word_ops: %u iterations passed\n", (unsigned)iterations);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Benchmark client partitions A and B. At boot both call the server as fast
+ * as they can, which shows how the scheduler shares it between two clients of
+ * equal priority. Then they forward the calls of the non-secure driver to the
+ * server, to measure nested calls.
+ */
+
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "psa/client.h"
+#include "psa/service.h"
+#include "psa_manifest/sid.h"
+#include "psa_manifest/tfm_sp_bench_client_a.h"
+#include "psa_manifest/tfm_sp_bench_client_b.h"
+
+static void bench_client_compete(void)
+{
+    psa_handle_t handle;
+    uint32_t i;
+
+    handle = psa_connect(BENCH_CONN_SERVICE_SID, BENCH_CONN_SERVICE_VERSION);
+    if (handle <= 0) {
+        bench_shared.errors++;
+        return;
+    }
+
+    for (i = 0; i < bench_config.fair_calls; i++) {
+        if (psa_call(handle, BENCH_OP_FAIR, NULL, 0, NULL, 0) != PSA_SUCCESS) {
+            bench_shared.errors++;
+        }
+    }
+
+    psa_close(handle);
+}
+
+static void bench_client_handle(psa_signal_t signal)
+{
+    uint8_t buf[BENCH_MAX_PAYLOAD];
+    psa_status_t status;
+    psa_msg_t msg;
+    psa_invec in_vec[1];
+    psa_outvec out_vec[1];
+
+    if (psa_get(signal, &msg) != PSA_SUCCESS) {
+        return;
+    }
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        status = PSA_SUCCESS;
+        break;
+    case BENCH_OP_NESTED:
+        in_vec[0].base = buf;
+        in_vec[0].len = psa_read(msg.handle, 0, buf, sizeof(buf));
+        out_vec[0].base = buf;
+        out_vec[0].len = in_vec[0].len;
+        if (out_vec[0].len > msg.out_size[0]) {
+            status = PSA_ERROR_BUFFER_TOO_SMALL;
+            break;
+        }
+        status = psa_call(BENCH_STATELESS_SERVICE_HANDLE, BENCH_OP_ECHO,
+                          in_vec, 1, out_vec, 1);
+        if (status == PSA_SUCCESS) {
+            psa_write(msg.handle, 0, buf, out_vec[0].len);
+        }
+        break;
+    default:
+        status = PSA_ERROR_NOT_SUPPORTED;
+        break;
+    }
+
+    psa_reply(msg.handle, status);
+}
+
+static void bench_client_main(psa_signal_t signal)
+{
+    bench_client_compete();
+
+    for (;;) {
+        if (psa_wait(signal, PSA_BLOCK) & signal) {
+            bench_client_handle(signal);
+        }
+    }
+}
+
+void bench_client_a_main(void)
+{
+    bench_client_main(BENCH_CLIENT_A_SERVICE_SIGNAL);
+}
+
+void bench_client_b_main(void)
+{
+    bench_client_main(BENCH_CLIENT_B_SERVICE_SIGNAL);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include <stdint.h>
+
+/*
+ * State shared by the benchmark partitions and the driver. The host SPM does
+ * not isolate partitions, so they report through plain globals.
+ */
+
+/* Request types of the benchmark services */
+#define BENCH_OP_ECHO               1   /* Write back invec[0] to outvec[0] */
+#define BENCH_OP_FAIR               2   /* Recorded in the fairness trace   */
+#define BENCH_OP_NESTED             3   /* Echo through the server          */
+
+/* Largest echoed payload, in bytes */
+#define BENCH_MAX_PAYLOAD           256
+
+/* Largest fairness trace, in calls */
+#define BENCH_TRACE_MAX             4096
+
+struct bench_config_t {
+    uint32_t fair_calls;            /* Calls of each client at boot */
+};
+
+struct bench_shared_t {
+    uint32_t errors;                /* Failed or mismatching calls  */
+    uint32_t trace_len;
+    int32_t  trace[BENCH_TRACE_MAX];/* Client ID of each fair call  */
+};
+
+extern struct bench_config_t bench_config;
+extern struct bench_shared_t bench_shared;
+
+#endif /* __BENCH_COMMON_H__ */
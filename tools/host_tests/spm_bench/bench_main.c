@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Benchmark of the IPC SPM on the host. The non-secure entry thread drives
+ * the measurements through the PSA client API; the SPM, its scheduler and the
+ * partitions are the target code, only the architecture layer is simulated.
+ * The host numbers compare SPM changes against each other. The switch and SVC
+ * counts per call are the same as on target.
+ *
+ * Usage: spm_bench [iterations] [payload bytes] [fairness calls per client]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "host_arch.h"
+#include "psa/client.h"
+#include "psa_manifest/pid.h"
+#include "psa_manifest/sid.h"
+
+struct bench_config_t bench_config = {
+    .fair_calls = 1000,
+};
+
+struct bench_shared_t bench_shared;
+
+struct bench_result_t {
+    const char *name;
+    uint32_t ops;
+    double ns;
+    struct host_arch_stats_t stats;
+};
+
+enum {
+    BENCH_CONN_CALL,
+    BENCH_STATELESS_CALL,
+    BENCH_CHURN,
+    BENCH_NESTED_CALL,
+    BENCH_COUNT
+};
+
+static struct bench_result_t bench_results[BENCH_COUNT];
+static uint32_t bench_iterations = 100000;
+static uint32_t bench_payload = 64;
+
+/* Buffers of the non-secure driver, static so that they are below 4GB */
+static uint8_t bench_in[BENCH_MAX_PAYLOAD];
+static uint8_t bench_out[BENCH_MAX_PAYLOAD];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* One echo call, the reply must match what was sent */
+static void bench_echo(psa_handle_t handle, int32_t type, uint32_t seq)
+{
+    psa_invec in_vec[] = {{bench_in, bench_payload}};
+    psa_outvec out_vec[] = {{bench_out, bench_payload}};
+
+    memcpy(bench_in, &seq, sizeof(seq));
+    if (psa_call(handle, type, in_vec, 1, out_vec, 1) != PSA_SUCCESS ||
+        out_vec[0].len != bench_payload ||
+        memcmp(bench_in, bench_out, bench_payload) != 0) {
+        bench_shared.errors++;
+    }
+}
+
+static void bench_conn_call(uint32_t n)
+{
+    psa_handle_t handle;
+    uint32_t i;
+
+    handle = psa_connect(BENCH_CONN_SERVICE_SID, BENCH_CONN_SERVICE_VERSION);
+    if (handle <= 0) {
+        bench_shared.errors++;
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        bench_echo(handle, BENCH_OP_ECHO, i);
+    }
+
+    psa_close(handle);
+}
+
+static void bench_stateless_call(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        bench_echo(BENCH_STATELESS_SERVICE_HANDLE, BENCH_OP_ECHO, i);
+    }
+}
+
+static void bench_churn(uint32_t n)
+{
+    psa_handle_t handle;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        handle = psa_connect(BENCH_CONN_SERVICE_SID,
+                             BENCH_CONN_SERVICE_VERSION);
+        if (handle <= 0) {
+            bench_shared.errors++;
+            continue;
+        }
+        bench_echo(handle, BENCH_OP_ECHO, i);
+        psa_close(handle);
+    }
+}
+
+static void bench_nested_call(uint32_t n)
+{
+    psa_handle_t handle;
+    uint32_t i;
+
+    handle = psa_connect(BENCH_CLIENT_A_SERVICE_SID,
+                         BENCH_CLIENT_A_SERVICE_VERSION);
+    if (handle <= 0) {
+        bench_shared.errors++;
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        bench_echo(handle, BENCH_OP_NESTED, i);
+    }
+
+    psa_close(handle);
+}
+
+static void bench_measure(struct bench_result_t *res, const char *name,
+                          void (*fn)(uint32_t n), uint32_t n)
+{
+    struct host_arch_stats_t before = host_arch_stats;
+    double start;
+
+    start = now_ns();
+    fn(n);
+    res->ns = now_ns() - start;
+
+    res->name = name;
+    res->ops = n;
+    res->stats.svc_count = host_arch_stats.svc_count - before.svc_count;
+    res->stats.pendsv_count = host_arch_stats.pendsv_count -
+                              before.pendsv_count;
+    res->stats.switch_count = host_arch_stats.switch_count -
+                              before.switch_count;
+}
+
+/* Entry of the non-secure thread, runs once the partitions wait */
+void tfm_nspm_thread_entry(void)
+{
+    bench_measure(&bench_results[BENCH_CONN_CALL], "connection call",
+                  bench_conn_call, bench_iterations);
+    bench_measure(&bench_results[BENCH_STATELESS_CALL], "stateless call",
+                  bench_stateless_call, bench_iterations);
+    bench_measure(&bench_results[BENCH_CHURN], "connect/call/close",
+                  bench_churn, bench_iterations);
+    bench_measure(&bench_results[BENCH_NESTED_CALL], "nested call",
+                  bench_nested_call, bench_iterations);
+
+    host_halt();
+}
+
+static uint32_t bench_report_fairness(void)
+{
+    uint32_t count_a = 0, count_b = 0, run = 0, longest_run = 0;
+    uint32_t i;
+
+    for (i = 0; i < bench_shared.trace_len; i++) {
+        if (bench_shared.trace[i] == TFM_SP_BENCH_CLIENT_A) {
+            count_a++;
+        } else if (bench_shared.trace[i] == TFM_SP_BENCH_CLIENT_B) {
+            count_b++;
+        }
+
+        if (i > 0 && bench_shared.trace[i] == bench_shared.trace[i - 1]) {
+            run++;
+        } else {
+            run = 1;
+        }
+        if (run > longest_run) {
+            longest_run = run;
+        }
+    }
+
+    printf("\nfairness: client A %u calls, client B %u calls, "
+           "longest run of one client %u\n",
+           (unsigned)count_a, (unsigned)count_b, (unsigned)longest_run);
+
+    /* Both clients must get all their calls served */
+    if (bench_shared.trace_len < BENCH_TRACE_MAX &&
+        (count_a != bench_config.fair_calls ||
+         count_b != bench_config.fair_calls)) {
+        printf("FAIL: a client was starved\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const struct bench_result_t *res;
+    uint32_t errors;
+    uint32_t i;
+
+    if (argc > 1) {
+        bench_iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        bench_payload = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        bench_config.fair_calls = (uint32_t)strtoul(argv[3], NULL, 0);
+    }
+    if (bench_payload < sizeof(uint32_t) || bench_payload > BENCH_MAX_PAYLOAD) {
+        printf("payload must be %u to %u bytes\n",
+               (unsigned)sizeof(uint32_t), (unsigned)BENCH_MAX_PAYLOAD);
+        return 1;
+    }
+
+    host_boot();
+
+    printf("%-20s %10s %10s %10s %10s\n",
+           "benchmark", "ops", "ns/op", "svc/op", "switch/op");
+    for (i = 0; i < BENCH_COUNT; i++) {
+        res = &bench_results[i];
+        if (res->ops == 0) {
+            continue;
+        }
+        printf("%-20s %10u %10.1f %10.2f %10.2f\n",
+               res->name, (unsigned)res->ops, res->ns / res->ops,
+               (double)res->stats.svc_count / res->ops,
+               (double)res->stats.switch_count / res->ops);
+    }
+
+    errors = bench_shared.errors + bench_report_fairness();
+    if (errors) {
+        printf("spm_bench: FAILED, %u errors\n", (unsigned)errors);
+        return 1;
+    }
+
+    printf("spm_bench: passed\n");
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Benchmark server partition: one connection based and one stateless echo. */
+
+#include <stdint.h>
+
+#include "bench_common.h"
+#include "psa/client.h"
+#include "psa/service.h"
+#include "psa_manifest/tfm_sp_bench_server.h"
+
+static void bench_server_handle(psa_signal_t signal)
+{
+    uint8_t buf[BENCH_MAX_PAYLOAD];
+    psa_msg_t msg;
+    size_t len;
+
+    if (psa_get(signal, &msg) != PSA_SUCCESS) {
+        return;
+    }
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        break;
+    case BENCH_OP_FAIR:
+        if (bench_shared.trace_len < BENCH_TRACE_MAX) {
+            bench_shared.trace[bench_shared.trace_len++] = msg.client_id;
+        }
+        break;
+    case BENCH_OP_ECHO:
+        len = psa_read(msg.handle, 0, buf, sizeof(buf));
+        if (len > msg.out_size[0]) {
+            psa_reply(msg.handle, PSA_ERROR_BUFFER_TOO_SMALL);
+            return;
+        }
+        psa_write(msg.handle, 0, buf, len);
+        break;
+    default:
+        psa_reply(msg.handle, PSA_ERROR_NOT_SUPPORTED);
+        return;
+    }
+
+    psa_reply(msg.handle, PSA_SUCCESS);
+}
+
+void bench_server_main(void)
+{
+    psa_signal_t signals;
+
+    for (;;) {
+        signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+
+        if (signals & BENCH_CONN_SERVICE_SIGNAL) {
+            bench_server_handle(BENCH_CONN_SERVICE_SIGNAL);
+        }
+        if (signals & BENCH_STATELESS_SERVICE_SIGNAL) {
+            bench_server_handle(BENCH_STATELESS_SERVICE_SIGNAL);
+        }
+    }
+}
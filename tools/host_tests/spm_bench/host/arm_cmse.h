@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __ARM_CMSE_H__
+#define __ARM_CMSE_H__
+
+/*
+ * Host replacement of the ACLE CMSE intrinsics. Non-secure callers are told
+ * apart by the host SVC frame instead, as the SPM does for IPC veneers.
+ */
+
+static inline int cmse_nonsecure_caller(void)
+{
+    return 0;
+}
+
+#endif /* __ARM_CMSE_H__ */
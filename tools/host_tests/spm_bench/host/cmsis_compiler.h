@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+/*
+ * Host replacement of the CMSIS compiler abstraction. The host SPM runs on a
+ * single host thread and interrupts are not simulated, so masking them and
+ * the barriers are no-ops.
+ */
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM                       __asm
+#endif
+#ifndef __INLINE
+#define __INLINE                    inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE             static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN                 __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED                      __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK                      __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED                    __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#endif
+
+__STATIC_INLINE void __disable_irq(void)
+{
+}
+
+__STATIC_INLINE void __enable_irq(void)
+{
+}
+
+__STATIC_INLINE uint32_t __get_PRIMASK(void)
+{
+    return 0;
+}
+
+__STATIC_INLINE void __set_PRIMASK(uint32_t primask)
+{
+    (void)primask;
+}
+
+__STATIC_INLINE uint8_t __CLZ(uint32_t value)
+{
+    return value ? (uint8_t)__builtin_clz(value) : 32U;
+}
+
+#define __DSB()                     __sync_synchronize()
+#define __DMB()                     __sync_synchronize()
+#define __ISB()                     __sync_synchronize()
+
+#endif /* __CMSIS_COMPILER_H__ */
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host architecture layer of the SPM: thread contexts, SVC and PendSV.
+ *
+ * The SPM passes pointers in 32-bit state context registers, so the program
+ * must be linked without PIE. All data then lies below 4GB, including the
+ * thread stacks, which are static arrays like on target.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "host_arch.h"
+#include "spm_ipc.h"
+#include "ffm/psa_client_service_apis.h"
+#include "tfm_arch.h"
+#include "tfm_core_trustzone.h"
+#include "tfm_core_utils.h"
+#include "tfm_thread.h"
+#include "utilities.h"
+
+struct host_arch_stats_t host_arch_stats;
+
+/* Context of the running thread, what PSP and PSPLIM hold on target */
+static struct tfm_arch_ctx_t host_psp_ctx;
+static bool host_pendsv_pending;
+
+/* Context of the caller of host_boot() */
+static ucontext_t host_main_uctx;
+
+void tfm_core_panic(void)
+{
+    fprintf(stderr, "spm_bench: SPM panic\n");
+    abort();
+}
+
+static uint32_t host_reg(uintptr_t val)
+{
+    if (val > UINT32_MAX) {
+        fprintf(stderr, "spm_bench: 0x%lx does not fit a register, "
+                "link without PIE\n", (unsigned long)val);
+        tfm_core_panic();
+    }
+
+    return (uint32_t)val;
+}
+
+void tfm_arch_trigger_pendsv(void)
+{
+    host_pendsv_pending = true;
+}
+
+void tfm_arch_update_ctx(struct tfm_arch_ctx_t *p_actx)
+{
+    host_psp_ctx = *p_actx;
+}
+
+/*
+ * Exception return. Service PendSV while it is pending and resume the thread
+ * the scheduler selected. The calling thread continues once it is selected
+ * again.
+ */
+static void host_exc_return(void)
+{
+    ucontext_t *p_prev;
+
+    while (host_pendsv_pending) {
+        host_pendsv_pending = false;
+        host_arch_stats.pendsv_count++;
+
+        p_prev = host_psp_ctx.uctx;
+        tfm_pendsv_do_schedule(&host_psp_ctx);
+
+        if (host_psp_ctx.uctx != p_prev) {
+            host_arch_stats.switch_count++;
+            swapcontext(p_prev, host_psp_ctx.uctx);
+        }
+    }
+}
+
+/* First instruction of every thread, the exception return into its entry */
+static void host_thread_start(void)
+{
+    struct tfm_state_context_t *p_stat_ctx;
+
+    host_exc_return();
+
+    p_stat_ctx = (struct tfm_state_context_t *)host_psp_ctx.sp;
+    ((void (*)(void *))(uintptr_t)p_stat_ctx->ra)(
+                                            (void *)(uintptr_t)p_stat_ctx->r0);
+
+    /* Thread exits are not allowed */
+    tfm_core_panic();
+}
+
+void tfm_arch_init_context(struct tfm_arch_ctx_t *p_actx,
+                           void *param, uintptr_t pfn,
+                           uintptr_t stk_btm, uintptr_t stk_top)
+{
+    struct tfm_state_context_t *p_stat_ctx =
+            (struct tfm_state_context_t *)tfm_arch_seal_thread_stack(stk_top);
+    ucontext_t *p_uctx;
+
+    /* The state context is on top, where the SVCs of the thread stack it */
+    p_stat_ctx--;
+
+    spm_memset(p_stat_ctx, 0, sizeof(*p_stat_ctx));
+    p_stat_ctx->r0 = host_reg((uintptr_t)param);
+    p_stat_ctx->ra = host_reg(pfn);
+    p_stat_ctx->lr = host_reg(pfn) & (~1UL);
+    p_stat_ctx->xpsr = XPSR_T32;
+
+    /* The host context is kept below it, the thread runs under both */
+    p_uctx = (ucontext_t *)(((uintptr_t)p_stat_ctx - sizeof(*p_uctx)) &
+                            ~(uintptr_t)0xF);
+    if (getcontext(p_uctx) != 0) {
+        tfm_core_panic();
+    }
+    p_uctx->uc_stack.ss_sp = (void *)stk_btm;
+    p_uctx->uc_stack.ss_size = (uintptr_t)p_uctx - stk_btm;
+    p_uctx->uc_link = NULL;
+    makecontext(p_uctx, host_thread_start, 0);
+
+    spm_memset(p_actx, 0, sizeof(*p_actx));
+    p_actx->sp = (uintptr_t)p_stat_ctx;
+    p_actx->sp_limit = stk_btm;
+    p_actx->lr = EXC_RETURN_THREAD_S_PSP;
+    p_actx->uctx = p_uctx;
+}
+
+/* The subset of SVC_Handler_IPC() the host PSA API uses */
+static uint32_t host_svc_handler(tfm_svc_number_t svc_num, uint32_t *ctx,
+                                 uint32_t lr, bool ns_caller)
+{
+    switch (svc_num) {
+    case TFM_SVC_PSA_FRAMEWORK_VERSION:
+        return tfm_spm_psa_framework_version();
+    case TFM_SVC_PSA_VERSION:
+        return tfm_spm_psa_version(ctx, ns_caller);
+    case TFM_SVC_PSA_CONNECT:
+        return tfm_spm_psa_connect(ctx, ns_caller);
+    case TFM_SVC_PSA_CALL:
+        return tfm_spm_psa_call(ctx, ns_caller, lr);
+    case TFM_SVC_PSA_CLOSE:
+        tfm_spm_psa_close(ctx, ns_caller);
+        break;
+    case TFM_SVC_PSA_WAIT:
+        return tfm_spm_psa_wait(ctx);
+    case TFM_SVC_PSA_GET:
+        return tfm_spm_psa_get(ctx);
+    case TFM_SVC_PSA_SET_RHANDLE:
+        tfm_spm_psa_set_rhandle(ctx);
+        break;
+    case TFM_SVC_PSA_READ:
+        return tfm_spm_psa_read(ctx);
+    case TFM_SVC_PSA_SKIP:
+        return tfm_spm_psa_skip(ctx);
+    case TFM_SVC_PSA_WRITE:
+        tfm_spm_psa_write(ctx);
+        break;
+    case TFM_SVC_PSA_REPLY:
+        tfm_spm_psa_reply(ctx);
+        break;
+    case TFM_SVC_PSA_NOTIFY:
+        tfm_spm_psa_notify(ctx);
+        break;
+    case TFM_SVC_PSA_CLEAR:
+        tfm_spm_psa_clear();
+        break;
+    case TFM_SVC_PSA_PANIC:
+        tfm_spm_psa_panic();
+        break;
+    default:
+        return (uint32_t)PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+uint32_t host_svc(tfm_svc_number_t svc_num, uintptr_t arg0, uintptr_t arg1,
+                  uintptr_t arg2, uintptr_t arg3)
+{
+    struct partition_t *partition = tfm_spm_get_running_partition();
+    struct tfm_state_context_t *p_stat_ctx;
+    uint32_t exc_return = EXC_RETURN_THREAD_S_PSP;
+    bool ns_caller;
+
+    if (!partition) {
+        tfm_core_panic();
+    }
+
+    /* Non-secure callers come in through the veneers */
+    ns_caller = (partition->p_static->pid == TFM_SP_NON_SECURE_ID);
+
+    /* Stack the state context, the veneer stack holds nothing else */
+    p_stat_ctx = (struct tfm_state_context_t *)
+                 (partition->sp_thread.stk_top - TFM_STACK_SEALED_SIZE) - 1;
+    p_stat_ctx->r0 = host_reg(arg0);
+    p_stat_ctx->r1 = host_reg(arg1);
+    p_stat_ctx->r2 = host_reg(arg2);
+    p_stat_ctx->r3 = host_reg(arg3);
+    p_stat_ctx->lr = ns_caller ? 0 : TFM_VENEER_LR_BIT0_MASK;
+    p_stat_ctx->xpsr = XPSR_T32;
+    host_psp_ctx.sp = (uintptr_t)p_stat_ctx;
+
+    host_arch_stats.svc_count++;
+
+    tfm_spm_validate_caller(partition, (uint32_t *)p_stat_ctx, exc_return,
+                            ns_caller);
+    p_stat_ctx->r0 = host_svc_handler(svc_num, (uint32_t *)p_stat_ctx,
+                                      exc_return, ns_caller);
+
+    host_exc_return();
+
+    /* A blocked caller gets its return value written when it is woken */
+    return p_stat_ctx->r0;
+}
+
+void host_boot(void)
+{
+    /* Handler mode initialization, tfm_core_handler_mode() on target */
+    (void)tfm_spm_init();
+
+    /* Return to the thread the scheduler was started with */
+    if (swapcontext(&host_main_uctx, host_psp_ctx.uctx) != 0) {
+        tfm_core_panic();
+    }
+}
+
+void host_halt(void)
+{
+    setcontext(&host_main_uctx);
+
+    /* setcontext() only returns on error */
+    tfm_core_panic();
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __HOST_ARCH_H__
+#define __HOST_ARCH_H__
+
+#include <stdint.h>
+#include "tfm/tfm_core_svc.h"
+
+/* Counters of the host "CPU", sampled by the benchmark around each run */
+struct host_arch_stats_t {
+    uint64_t svc_count;             /* SVCs taken                   */
+    uint64_t pendsv_count;          /* PendSVs serviced             */
+    uint64_t switch_count;          /* Thread context switches      */
+};
+
+extern struct host_arch_stats_t host_arch_stats;
+
+/**
+ * \brief Take an SVC from the running thread.
+ *
+ * The arguments are stacked into the state context frame of the thread, the
+ * request is handled by the SPM and pending PendSVs are serviced before the
+ * thread continues, as on target.
+ *
+ * \return The r0 value in the frame once the thread runs again.
+ */
+uint32_t host_svc(tfm_svc_number_t svc_num, uintptr_t arg0, uintptr_t arg1,
+                  uintptr_t arg2, uintptr_t arg3);
+
+/**
+ * \brief Initialize the SPM and run the partitions and the non-secure entry
+ *        thread until the non-secure thread calls host_halt().
+ */
+void host_boot(void);
+
+/**
+ * \brief Stop the host SPM and return to the caller of host_boot().
+ */
+void host_halt(void);
+
+#endif /* __HOST_ARCH_H__ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Platform HAL of the host SPM. There is no isolation hardware and no
+ * interrupt, every access check passes.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tfm_hal_defs.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
+#include "tfm_nspm.h"
+#include "tfm_spm_hal.h"
+
+/* Client ID of the single non-secure thread, as tfm_nspm_ipc.c defaults to */
+#define DEFAULT_NS_CLIENT_ID ((int32_t)-1)
+
+enum tfm_hal_status_t tfm_hal_memory_has_access(uintptr_t base,
+                                                size_t size,
+                                                uint32_t attr)
+{
+    (void)base;
+    (void)size;
+    (void)attr;
+
+    return TFM_HAL_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_spm_hal_configure_default_isolation(
+                  uint32_t partition_idx,
+                  const struct platform_data_t *platform_data)
+{
+    (void)partition_idx;
+    (void)platform_data;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+uint32_t tfm_spm_hal_get_ns_entry_point(void)
+{
+    return 0;
+}
+
+void tfm_spm_hal_clear_pending_irq(IRQn_Type irq_line)
+{
+    (void)irq_line;
+}
+
+void tfm_spm_hal_enable_irq(IRQn_Type irq_line)
+{
+    (void)irq_line;
+}
+
+void tfm_spm_hal_disable_irq(IRQn_Type irq_line)
+{
+    (void)irq_line;
+}
+
+void tfm_hal_system_reset(void)
+{
+    fprintf(stderr, "spm_bench: system reset requested\n");
+    abort();
+}
+
+int32_t tfm_nspm_get_current_client_id(void)
+{
+    return DEFAULT_NS_CLIENT_ID;
+}
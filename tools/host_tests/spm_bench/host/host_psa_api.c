@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * PSA client and service APIs of the host SPM. Each one takes the SVC the
+ * target library takes, see interface/src/psa. The non-secure entry thread
+ * uses the same client functions, the SPM sees it as a veneer caller.
+ */
+
+#include <stdint.h>
+
+#include "host_arch.h"
+#include "psa/client.h"
+#include "psa/service.h"
+#include "tfm_api.h"
+
+/**** PSA client APIs ****/
+
+uint32_t psa_framework_version(void)
+{
+    return host_svc(TFM_SVC_PSA_FRAMEWORK_VERSION, 0, 0, 0, 0);
+}
+
+uint32_t psa_version(uint32_t sid)
+{
+    return host_svc(TFM_SVC_PSA_VERSION, sid, 0, 0, 0);
+}
+
+psa_handle_t psa_connect(uint32_t sid, uint32_t version)
+{
+    return (psa_handle_t)host_svc(TFM_SVC_PSA_CONNECT, sid, version, 0, 0);
+}
+
+psa_status_t psa_call(psa_handle_t handle, int32_t type,
+                      const psa_invec *in_vec, size_t in_len,
+                      psa_outvec *out_vec, size_t out_len)
+{
+    struct tfm_control_parameter_t ctrl_param;
+
+    ctrl_param.type = type;
+    ctrl_param.in_len = in_len;
+    ctrl_param.out_len = out_len;
+
+    return (psa_status_t)host_svc(TFM_SVC_PSA_CALL, (uint32_t)handle,
+                                  (uintptr_t)&ctrl_param, (uintptr_t)in_vec,
+                                  (uintptr_t)out_vec);
+}
+
+void psa_close(psa_handle_t handle)
+{
+    (void)host_svc(TFM_SVC_PSA_CLOSE, (uint32_t)handle, 0, 0, 0);
+}
+
+/**** PSA service APIs ****/
+
+psa_signal_t psa_wait(psa_signal_t signal_mask, uint32_t timeout)
+{
+    return host_svc(TFM_SVC_PSA_WAIT, signal_mask, timeout, 0, 0);
+}
+
+psa_status_t psa_get(psa_signal_t signal, psa_msg_t *msg)
+{
+    return (psa_status_t)host_svc(TFM_SVC_PSA_GET, signal, (uintptr_t)msg,
+                                  0, 0);
+}
+
+void psa_set_rhandle(psa_handle_t msg_handle, void *rhandle)
+{
+    (void)host_svc(TFM_SVC_PSA_SET_RHANDLE, (uint32_t)msg_handle,
+                   (uintptr_t)rhandle, 0, 0);
+}
+
+size_t psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
+                void *buffer, size_t num_bytes)
+{
+    return host_svc(TFM_SVC_PSA_READ, (uint32_t)msg_handle, invec_idx,
+                    (uintptr_t)buffer, num_bytes);
+}
+
+size_t psa_skip(psa_handle_t msg_handle, uint32_t invec_idx, size_t num_bytes)
+{
+    return host_svc(TFM_SVC_PSA_SKIP, (uint32_t)msg_handle, invec_idx,
+                    num_bytes, 0);
+}
+
+void psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
+               const void *buffer, size_t num_bytes)
+{
+    (void)host_svc(TFM_SVC_PSA_WRITE, (uint32_t)msg_handle, outvec_idx,
+                   (uintptr_t)buffer, num_bytes);
+}
+
+void psa_reply(psa_handle_t msg_handle, psa_status_t status)
+{
+    (void)host_svc(TFM_SVC_PSA_REPLY, (uint32_t)msg_handle, (uint32_t)status,
+                   0, 0);
+}
+
+void psa_notify(int32_t partition_id)
+{
+    (void)host_svc(TFM_SVC_PSA_NOTIFY, (uint32_t)partition_id, 0, 0, 0);
+}
+
+void psa_clear(void)
+{
+    (void)host_svc(TFM_SVC_PSA_CLEAR, 0, 0, 0, 0);
+}
+
+void psa_panic(void)
+{
+    (void)host_svc(TFM_SVC_PSA_PANIC, 0, 0, 0, 0);
+}
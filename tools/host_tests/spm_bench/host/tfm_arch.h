@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#ifndef __TFM_ARCH_H__
+#define __TFM_ARCH_H__
+
+/*
+ * Host replacement of the architecture layer for the host simulated SPM.
+ *
+ * Each thread runs on its own static stack in a host ucontext. The SVC state
+ * context is kept in a frame at the top of the thread stack, where an Armv8-M
+ * veneer call would have stacked it, so the SPM reads arguments and writes
+ * return values exactly as on target. PendSV is a pending flag which the host
+ * exception return in host_arch.c services.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include "tfm_hal_device_header.h"
+#include "cmsis_compiler.h"
+#include "tfm_core_trustzone.h"
+#include "utilities.h"
+
+#define EXC_RETURN_INDICATOR                    (0xFFUL << 24)
+#define EXC_RETURN_RES1                         (0x1FFFFUL << 7)
+#define EXC_RETURN_SECURE_STACK                 (1UL << 6)
+#define EXC_RETURN_STACK_RULE                   (1UL << 5)
+#define EXC_RETURN_FPU_FRAME_BASIC              (1UL << 4)
+#define EXC_RETURN_MODE_THREAD                  (1UL << 3)
+#define EXC_RETURN_STACK_PROCESS                (1UL << 2)
+#define EXC_RETURN_RES0                         (0UL << 1)
+#define EXC_RETURN_EXC_SECURE                   (1UL)
+
+/* EXC_RETURN of a secure thread using PSP, as on Armv8-M */
+#define EXC_RETURN_THREAD_S_PSP                                 \
+        EXC_RETURN_INDICATOR | EXC_RETURN_RES1 |                \
+        EXC_RETURN_SECURE_STACK | EXC_RETURN_STACK_RULE |       \
+        EXC_RETURN_FPU_FRAME_BASIC | EXC_RETURN_MODE_THREAD |   \
+        EXC_RETURN_STACK_PROCESS | EXC_RETURN_RES0 |            \
+        EXC_RETURN_EXC_SECURE
+
+#define XPSR_T32            0x01000000
+
+/* General core state context */
+struct tfm_state_context_t {
+    uint32_t    r0;
+    uint32_t    r1;
+    uint32_t    r2;
+    uint32_t    r3;
+    uint32_t    r12;
+    uint32_t    lr;
+    uint32_t    ra;
+    uint32_t    xpsr;
+};
+
+/* Thread context, switched by value like the Armv8-M one */
+struct tfm_arch_ctx_t {
+    uintptr_t   sp;                 /* State context frame of the thread */
+    uintptr_t   sp_limit;
+    uint32_t    lr;                 /* EXC_RETURN                        */
+    void        *uctx;              /* Host execution context            */
+};
+
+#define TFM_STATE_RET_VAL(ctx) (((struct tfm_state_context_t *)((ctx)->sp))->r0)
+
+/* Host PendSV, serviced by host_exc_return() */
+void tfm_arch_trigger_pendsv(void);
+
+/* Set the host "PSP" to the given thread context */
+void tfm_arch_update_ctx(struct tfm_arch_ctx_t *p_actx);
+
+__STATIC_INLINE bool is_return_secure_stack(uint32_t lr)
+{
+    return (lr & EXC_RETURN_SECURE_STACK);
+}
+
+__STATIC_INLINE bool is_stack_alloc_fp_space(uint32_t lr)
+{
+    return (lr & EXC_RETURN_FPU_FRAME_BASIC) ? false : true;
+}
+
+__STATIC_INLINE uintptr_t tfm_arch_seal_thread_stack(uintptr_t stk)
+{
+    TFM_CORE_ASSERT((stk & 0x7) == 0);
+    stk -= TFM_STACK_SEALED_SIZE;
+
+    *((uint32_t *)stk)       = TFM_STACK_SEAL_VALUE;
+    *((uint32_t *)(stk + 4)) = TFM_STACK_SEAL_VALUE;
+
+    return stk;
+}
+
+__STATIC_INLINE bool tfm_arch_cas_u32(volatile uint32_t *addr,
+                                      uint32_t old_val, uint32_t new_val)
+{
+    return __atomic_compare_exchange_n(addr, &old_val, new_val, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+__STATIC_INLINE uint32_t tfm_arch_fetch_add_u32(volatile uint32_t *addr,
+                                                uint32_t delta)
+{
+    return __atomic_fetch_add(addr, delta, __ATOMIC_SEQ_CST);
+}
+
+/* Clear float point status, nothing to clear on host. */
+__STATIC_INLINE void tfm_arch_clear_fp_status(void)
+{
+}
+
+void tfm_arch_init_context(struct tfm_arch_ctx_t *p_actx,
+                           void *param, uintptr_t pfn,
+                           uintptr_t stk_btm, uintptr_t stk_top);
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+ * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_HAL_DEVICE_HEADER_H__
+#define __TFM_HAL_DEVICE_HEADER_H__
+
+/* The host SPM has no device, only the types the SPM interfaces use. */
+
+#include "cmsis_compiler.h"
+
+typedef enum {
+    HOST_NO_IRQn = -1,
+} IRQn_Type;
+
+/* EXC_RETURN bits checked by the SVC handler, from the CMSIS core header */
+#define EXC_RETURN_MODE             (0x00000008UL)
+#define EXC_RETURN_SPSEL            (0x00000004UL)
+
+#endif /* __TFM_HAL_DEVICE_HEADER_H__ */
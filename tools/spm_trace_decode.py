@@ -0,0 +1,217 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
+# or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Decode the SPM IPC trace buffer.
+
+Build with -DTFM_SPM_TRACE=ON, run the workload, then dump the 'g_spm_trace'
+symbol to a binary file with a debugger, for example in GDB:
+
+    dump binary value spm_trace.bin g_spm_trace
+
+This script prints per-service latency histograms and context switch counts
+from the dump. The layout must match secure_fw/spm/include/tfm_spm_trace.h.
+"""
+
+import argparse
+import struct
+import sys
+from collections import defaultdict, deque
+
+TRACE_MAGIC = 0x45435254
+TRACE_VERSION = 1
+
+HEADER_FMT = '<IHHII'
+ENTRY_FMT = '<IIiI'
+
+EVT_CONNECT = 1
+EVT_CALL = 2
+EVT_CLOSE = 3
+EVT_GET = 4
+EVT_REPLY = 5
+EVT_SWITCH = 6
+EVT_IRQ_SIGNAL = 7
+
+EVT_NAMES = {
+    EVT_CONNECT: 'CONNECT',
+    EVT_CALL: 'CALL',
+    EVT_CLOSE: 'CLOSE',
+    EVT_GET: 'GET',
+    EVT_REPLY: 'REPLY',
+    EVT_SWITCH: 'SWITCH',
+    EVT_IRQ_SIGNAL: 'IRQ_SIGNAL',
+}
+
+INFO_EVT_MASK = 0xFF
+INFO_SEQ_POS = 8
+INFO_SEQ_MASK = 0xFFFFFFFF >> INFO_SEQ_POS
+
+TIMESTAMP_MASK = 0xFFFFFFFF
+
+
+def parse_trace(data):
+    """Return the complete trace entries ordered by sequence number."""
+    hdr_size = struct.calcsize(HEADER_FMT)
+    if len(data) < hdr_size:
+        sys.exit('Trace dump is too short')
+
+    magic, version, entry_size, entry_num, next_seq = \
+        struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != TRACE_MAGIC:
+        sys.exit('Bad trace magic 0x{:08x}'.format(magic))
+    if version != TRACE_VERSION:
+        sys.exit('Unsupported trace version {}'.format(version))
+    if entry_size != struct.calcsize(ENTRY_FMT):
+        sys.exit('Unsupported trace entry size {}'.format(entry_size))
+    if len(data) < hdr_size + entry_size * entry_num:
+        sys.exit('Trace dump is truncated')
+
+    entries = []
+    for idx in range(entry_num):
+        timestamp, key, client_id, info = \
+            struct.unpack_from(ENTRY_FMT, data, hdr_size + idx * entry_size)
+        if info == 0:
+            continue
+
+        # Latest sequence number which maps to this slot
+        if next_seq == 0 or (next_seq - 1) % entry_num < idx:
+            if next_seq < entry_num:
+                continue
+            seq = ((next_seq - 1) // entry_num - 1) * entry_num + idx
+        else:
+            seq = ((next_seq - 1) // entry_num) * entry_num + idx
+
+        # A stale or partially written entry carries another sequence number
+        if (info >> INFO_SEQ_POS) != (seq & INFO_SEQ_MASK):
+            continue
+
+        entries.append((seq, info & INFO_EVT_MASK, timestamp, key, client_id))
+
+    entries.sort()
+    lost = next_seq - len(entries)
+    return entries, lost
+
+
+class Histogram:
+    """Latency histogram with power of two buckets."""
+
+    def __init__(self):
+        self.buckets = defaultdict(int)
+        self.count = 0
+        self.total = 0
+        self.min = None
+        self.max = 0
+
+    def add(self, value):
+        self.buckets[value.bit_length()] += 1
+        self.count += 1
+        self.total += value
+        self.min = value if self.min is None else min(self.min, value)
+        self.max = max(self.max, value)
+
+    def dump(self, title):
+        if self.count == 0:
+            return
+        print('    {}: count {} min {} avg {} max {}'.format(
+            title, self.count, self.min, self.total // self.count, self.max))
+        scale = max(self.buckets.values())
+        for bucket in sorted(self.buckets):
+            low = 0 if bucket == 0 else 1 << (bucket - 1)
+            high = (1 << bucket) - 1
+            num = self.buckets[bucket]
+            print('      [{:>10} - {:>10}] {:>6} {}'.format(
+                low, high, num, '#' * max(1, num * 40 // scale)))
+
+
+class ServiceStats:
+
+    def __init__(self):
+        self.queue = Histogram()
+        self.service = Histogram()
+        self.total = Histogram()
+        self.events = defaultdict(int)
+        self.switches = 0
+        self.replied = 0
+
+
+def analyse(entries):
+    services = defaultdict(ServiceStats)
+    # In flight messages per (SID, client ID): [send time, get time, switches]
+    pending = defaultdict(deque)
+    switches = 0
+    irqs = defaultdict(int)
+
+    for _, event, timestamp, key, client_id in entries:
+        if event in (EVT_CONNECT, EVT_CALL, EVT_CLOSE):
+            services[key].events[event] += 1
+            pending[(key, client_id)].append([timestamp, None, switches])
+        elif event == EVT_GET:
+            for msg in pending[(key, client_id)]:
+                if msg[1] is None:
+                    msg[1] = timestamp
+                    break
+        elif event == EVT_REPLY:
+            queue = pending[(key, client_id)]
+            if not queue or queue[0][1] is None:
+                # The request was recorded before the start of the trace
+                continue
+            sent, got, switched = queue.popleft()
+            stats = services[key]
+            stats.queue.add((got - sent) & TIMESTAMP_MASK)
+            stats.service.add((timestamp - got) & TIMESTAMP_MASK)
+            stats.total.add((timestamp - sent) & TIMESTAMP_MASK)
+            stats.switches += switches - switched
+            stats.replied += 1
+        elif event == EVT_SWITCH:
+            switches += 1
+        elif event == EVT_IRQ_SIGNAL:
+            irqs[(key, client_id)] += 1
+
+    return services, switches, irqs
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the SPM IPC trace')
+    parser.add_argument('dump', help='binary dump of g_spm_trace')
+    parser.add_argument('-r', '--raw', action='store_true',
+                        help='print the decoded events')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as f:
+        entries, lost = parse_trace(f.read())
+
+    print('{} events decoded, {} overwritten or incomplete'.format(
+        len(entries), lost))
+
+    if args.raw:
+        for seq, event, timestamp, key, client_id in entries:
+            print('{:>8} {:>10} {:<10} 0x{:08x} {}'.format(
+                seq, timestamp, EVT_NAMES.get(event, str(event)), key,
+                client_id))
+
+    services, switches, irqs = analyse(entries)
+
+    print('Context switches: {}'.format(switches))
+    for (partition_id, irq_line), num in sorted(irqs.items()):
+        print('IRQ {} to partition {}: {}'.format(irq_line, partition_id, num))
+
+    for sid in sorted(services):
+        stats = services[sid]
+        print('SID 0x{:08x}: {}'.format(sid, ', '.join(
+            '{} {}'.format(EVT_NAMES[evt], num)
+            for evt, num in sorted(stats.events.items()))))
+        if stats.replied:
+            print('    context switches per message: {:.2f}'.format(
+                stats.switches / stats.replied))
+        stats.queue.dump('queue latency (send to get)')
+        stats.service.dump('service latency (get to reply)')
+        stats.total.dump('total latency (send to reply)')
+
+
+if __name__ == '__main__':
+    main()